@@ -438,6 +438,16 @@ static void cai_switch_to_explore(struct unit *punit, struct tile *target,
   dai_switch_to_explore(deftype, punit, target, allow);
 }
 
+/**********************************************************************//**
+  Call default ai with classic ai type as parameter.
+**************************************************************************/
+static void cai_do_phase_plan(struct player *pplayer)
+{
+  struct ai_type *deftype = classic_ai_get_self();
+
+  dai_do_phase_plan(deftype, pplayer);
+}
+
 /**********************************************************************//**
   Call default ai with classic ai type as parameter.
 **************************************************************************/
@@ -574,6 +584,46 @@ static void cai_consider_wonder_city(struct city *pcity, bool *result)
   dai_consider_wonder_city(deftype, pcity, result);
 }
 
+/**********************************************************************//**
+  Free default ai data tied to the map.
+**************************************************************************/
+static void cai_map_free(void)
+{
+  dai_threats_free();
+}
+
+/**********************************************************************//**
+  Tell default ai that a tile changed.
+**************************************************************************/
+static void cai_tile_info(struct tile *ptile)
+{
+  dai_threats_invalidate();
+}
+
+/**********************************************************************//**
+  Tell default ai that a city appeared, changed owner or disappeared.
+**************************************************************************/
+static void cai_city_changed(struct city *pcity)
+{
+  dai_threats_invalidate();
+}
+
+/**********************************************************************//**
+  Tell default ai that a unit appeared or moved.
+**************************************************************************/
+static void cai_unit_moved(struct unit *punit)
+{
+  dai_threats_unit_moved(punit);
+}
+
+/**********************************************************************//**
+  Tell default ai that a unit changed or disappeared.
+**************************************************************************/
+static void cai_unit_changed(struct unit *punit)
+{
+  dai_threats_invalidate();
+}
+
 /**********************************************************************//**
   Setup player ai_funcs function pointers.
 **************************************************************************/
@@ -593,7 +643,7 @@ bool fc_ai_classic_setup(struct ai_type *ai)
 
   /* ai->funcs.map_alloc = NULL; */
   /* ai->funcs.map_ready = NULL; */
-  /* ai->funcs.map_free = NULL; */
+  ai->funcs.map_free = cai_map_free;
   /* ai->funcs.game_start = NULL; */
   /* ai->funcs.game_free = NULL; */
 
@@ -613,9 +663,9 @@ bool fc_ai_classic_setup(struct ai_type *ai)
 
   ai->funcs.city_alloc = cai_city_alloc;
   ai->funcs.city_free = cai_city_free;
+  ai->funcs.city_created = cai_city_changed;
+  ai->funcs.city_destroyed = cai_city_changed;
   /*
-    ai->funcs.city_created = NULL;
-    ai->funcs.city_destroyed = NULL;
     ai->funcs.city_got = NULL;
     ai->funcs.city_lost = NULL;
   */
@@ -639,20 +689,20 @@ bool fc_ai_classic_setup(struct ai_type *ai)
   /*
     ai->funcs.unit_alloc = NULL;
     ai->funcs.unit_free = NULL;
-    ai->funcs.unit_created = NULL;
-    ai->funcs.unit_destroyed = NULL;
     ai->funcs.unit_got = dai_unit_init;
     ai->funcs.unit_lost = dai_unit_close;
   */
   ai->funcs.unit_alloc = cai_unit_init;
   ai->funcs.unit_free = cai_unit_close;
+  ai->funcs.unit_created = cai_unit_moved;
+  ai->funcs.unit_destroyed = cai_unit_changed;
   ai->funcs.unit_got = cai_ferry_init_ferry;
   ai->funcs.unit_lost = cai_ferry_lost;
   ai->funcs.unit_transformed = cai_ferry_transformed;
 
   ai->funcs.unit_turn_end = cai_unit_turn_end;
   ai->funcs.unit_move = cai_unit_move_or_attack;
-  /* ai->funcs.unit_move_seen = NULL; */
+  ai->funcs.unit_move_seen = cai_unit_moved;
   ai->funcs.unit_task = cai_unit_new_adv_task;
 
   ai->funcs.unit_save = cai_unit_save;
@@ -664,6 +714,7 @@ bool fc_ai_classic_setup(struct ai_type *ai)
 
   ai->funcs.want_to_explore = cai_switch_to_explore;
 
+  ai->funcs.phase_plan = cai_do_phase_plan;
   ai->funcs.first_activities = cai_do_first_activities;
   ai->funcs.restart_phase = cai_restart_phase;
   ai->funcs.diplomacy_actions = cai_diplomacy_actions;
@@ -682,9 +733,9 @@ bool fc_ai_classic_setup(struct ai_type *ai)
 
   /* ai->funcs.refresh = NULL; */
 
-  /* ai->funcs.tile_info = NULL; */
-  /* ai->funcs.city_info = NULL; */
-  /* ai->funcs.unit_info = NULL; */
+  ai->funcs.tile_info = cai_tile_info;
+  ai->funcs.city_info = cai_city_changed;
+  ai->funcs.unit_info = cai_unit_changed;
 
   return TRUE;
 }
@@ -874,6 +874,7 @@ void dai_manage_cities(struct ai_type *ait, struct player *pplayer)
 
   /* Initialize the infrastructure cache, which is used shortly. */
   initialize_infrastructure_cache(pplayer);
+  dai_threats_begin(ait, pplayer, &(wld.map));
   city_list_iterate(pplayer->cities, pcity) {
     struct ai_city *city_data = def_ai_city_data(pcity, ait);
     struct adv_choice *choice;
@@ -915,6 +916,7 @@ void dai_manage_cities(struct ai_type *ait, struct player *pplayer)
     TIMING_LOG(AIT_CITY_SETTLERS, TIMER_STOP);
     ADV_CHOICE_ASSERT(city_data->choice);
   } city_list_iterate_end;
+  dai_threats_end(ait, pplayer);
   /* Reset auto settler state for the next run. */
   dai_auto_settler_reset(ait, pplayer);
 
@@ -1425,6 +1427,57 @@ adv_want dai_city_want(struct player *pplayer, struct city *acity,
   return want;
 }
 
+/* Incremented for each improvement the building advisor evaluates.
+ * Identifies which ai_city->other_want values are current. */
+static int base_want_pass = 0;
+
+/**********************************************************************//**
+  Whether adding the improvement to a city changes the other cities of
+  the player the same way no matter which city gets it. This holds when
+  the improvement's effects reach other cities only through continent,
+  player or wider ranges. Then the want change of every other city in
+  range is the same for all the cities base_want() is calculated for,
+  and needs to be calculated only once.
+**************************************************************************/
+static bool impr_other_want_shared(const struct adv_data *adv,
+                                   const struct impr_type *pimprove)
+{
+  struct universal source = {
+    .kind = VUT_IMPROVEMENT,
+    .value = {.building = improvement_by_number(improvement_number(pimprove))}
+  };
+
+  switch (adv->impr_range[improvement_index(pimprove)]) {
+  case REQ_RANGE_CONTINENT:
+  case REQ_RANGE_PLAYER:
+  case REQ_RANGE_TEAM:
+  case REQ_RANGE_ALLIANCE:
+    break;
+  default:
+    return FALSE;
+  }
+
+  effect_list_iterate(get_req_source_effects(&source), peffect) {
+    if (peffect->type == EFT_GOV_CENTER
+        || peffect->type == EFT_CAPITAL_CITY) {
+      /* Waste of other cities depends on where these are. */
+      return FALSE;
+    }
+
+    requirement_vector_iterate(&peffect->reqs, preq) {
+      if (VUT_IMPROVEMENT == preq->source.kind
+          && preq->source.value.building == pimprove
+          && (preq->range == REQ_RANGE_TRADEROUTE
+              || preq->range == REQ_RANGE_ADJACENT
+              || preq->range == REQ_RANGE_CADJACENT)) {
+        return FALSE;
+      }
+    } requirement_vector_iterate_end;
+  } effect_list_iterate_end;
+
+  return TRUE;
+}
+
 /**********************************************************************//**
   Calculates want for some buildings by actually adding the building and
   measuring the effect.
@@ -1436,6 +1489,7 @@ static adv_want base_want(struct ai_type *ait, struct player *pplayer,
   adv_want final_want = 0;
   int wonder_player_id = WONDER_NOT_OWNED;
   int wonder_city_id = WONDER_NOT_BUILT;
+  bool shared;
 
   if (adv->impr_calc[improvement_index(pimprove)] == ADV_IMPR_ESTIMATE) {
     return 0; /* Nothing to calculate here. */
@@ -1447,6 +1501,8 @@ static adv_want base_want(struct ai_type *ait, struct player *pplayer,
     return 0;
   }
 
+  shared = impr_other_want_shared(adv, pimprove);
+
   if (is_wonder(pimprove)) {
     if (is_great_wonder(pimprove)) {
       wonder_player_id =
@@ -1460,8 +1516,21 @@ static adv_want base_want(struct ai_type *ait, struct player *pplayer,
   /* Stir, then compare notes */
   city_range_iterate(pcity, pplayer->cities,
                      adv->impr_range[improvement_index(pimprove)], acity) {
-    final_want += dai_city_want(pplayer, acity, adv, pimprove)
-      - def_ai_city_data(acity, ait)->worth;
+    struct ai_city *acity_data = def_ai_city_data(acity, ait);
+
+    if (!shared || acity == pcity) {
+      final_want += dai_city_want(pplayer, acity, adv, pimprove)
+        - acity_data->worth;
+    } else {
+      /* The same for any other city getting the improvement, so
+       * calculate only once per advisor pass. */
+      if (acity_data->other_want_pass != base_want_pass) {
+        acity_data->other_want = dai_city_want(pplayer, acity, adv, pimprove)
+          - acity_data->worth;
+        acity_data->other_want_pass = base_want_pass;
+      }
+      final_want += acity_data->other_want;
+    }
   } city_range_iterate_end;
 
   /* Restore */
@@ -1885,6 +1954,9 @@ void dai_build_adv_adjust(struct ai_type *ait, struct player *pplayer,
   improvement_iterate(pimprove) {
     const bool is_coinage = improvement_has_flag(pimprove, IF_GOLD);
 
+    /* Shared other city wants of the previous improvement are stale. */
+    base_want_pass++;
+
     /* Handle coinage specially because you can never complete coinage */
     if (is_coinage
         || can_player_build_improvement_later(pplayer, pimprove)) {
@@ -66,6 +66,12 @@ struct ai_city {
   int founder_want;
   int worker_want;
   struct unit_type *worker_type;
+
+  /* Want change of this city when another city of ours gets the
+   * improvement being evaluated. Valid during the building advisor pass
+   * other_want_pass only; see base_want(). */
+  adv_want other_want;
+  int other_want_pass;
 };
 
 void dai_manage_cities(struct ai_type *ait, struct player *pplayer);
@@ -90,6 +90,7 @@ void dai_data_init(struct ai_type *ait, struct player *pplayer)
   ai->diplomacy.req_love_for_alliance = MAX_AI_LOVE / 4;
 
   ai->settler = NULL;
+  ai->threats = NULL;
 
   /* Initialise autosettler. */
   dai_auto_settler_init(ai);
@@ -101,6 +101,9 @@ struct ai_plr
   /* Cache map for AI settlers; defined in aisettler.c. */
   struct ai_settler *settler;
 
+  /* Enemy unit reach for danger assessment; defined in daimilitary.c. */
+  struct dai_threats *threats;
+
   /* The units of tech_want seem to be shields */
   adv_want tech_want[A_LAST+1];
 };
@@ -729,17 +729,28 @@ static void dai_manage_government(struct ai_type *ait, struct player *pplayer)
 }
 
 /*************************************************************************//**
-  Activities to be done by AI _before_ human turn.  Here we just move the
-  units intelligently.
+  Planning to be done by AI before any AI player of the phase moves. Every
+  AI player gets to assess the danger to its cities against the same
+  positions of all units, which also lets them share the threat data
+  computed for those units.
 *****************************************************************************/
-void dai_do_first_activities(struct ai_type *ait, struct player *pplayer)
+void dai_do_phase_plan(struct ai_type *ait, struct player *pplayer)
 {
   TIMING_LOG(AIT_ALL, TIMER_START);
   dai_assess_danger_player(ait, pplayer, &(wld.map));
   /* TODO: Make assess_danger save information on what is threatening
    * us and make dai_manage_units and Co act upon this information, trying
    * to eliminate the source of danger */
+  TIMING_LOG(AIT_ALL, TIMER_STOP);
+}
 
+/*************************************************************************//**
+  Activities to be done by AI _before_ human turn.  Here we just move the
+  units intelligently. Danger has been assessed in dai_do_phase_plan().
+*****************************************************************************/
+void dai_do_first_activities(struct ai_type *ait, struct player *pplayer)
+{
+  TIMING_LOG(AIT_ALL, TIMER_START);
   TIMING_LOG(AIT_UNITS, TIMER_START);
   dai_manage_units(ait, pplayer);
   TIMING_LOG(AIT_UNITS, TIMER_STOP);
@@ -141,8 +141,26 @@ static void tile_data_cache_destroy(struct tile_data_cache *ptdc);
 #define SPECHASH_IDATA_FREE tile_data_cache_destroy
 #include "spechash.h"
 
+struct cityresult;
+
+/* Value of a city site, independent of the unit that would found it. */
+struct site_data_cache {
+  struct cityresult *cr;  /* evaluated site */
+  int turn;               /* the turn the site was evaluated */
+};
+
+static void site_data_cache_destroy(struct site_data_cache *psdc);
+
+/* struct site_data_cache_hash. */
+#define SPECHASH_TAG site_data_cache
+#define SPECHASH_INT_KEY_TYPE
+#define SPECHASH_IDATA_TYPE struct site_data_cache *
+#define SPECHASH_IDATA_FREE site_data_cache_destroy
+#include "spechash.h"
+
 struct ai_settler {
   struct tile_data_cache_hash *tdc_hash;
+  struct site_data_cache_hash *site_hash;
 
 #ifdef FREECIV_DEBUG
   struct {
@@ -151,6 +169,10 @@ struct ai_settler {
     int miss;
     int save;
   } cache;
+  struct {
+    int hit;
+    int miss;
+  } site_cache;
 #endif /* FREECIV_DEBUG */
 };
 
@@ -190,7 +212,10 @@ static void tdc_plr_set(struct ai_type *ait, struct player *plr, int tindex,
                         const struct tile_data_cache *tdcache);
 
 static struct cityresult *cityresult_new(struct tile *ptile);
+static struct cityresult *cityresult_copy(const struct cityresult *result);
 static void cityresult_destroy(struct cityresult *result);
+static bool cityresult_is_current(struct player *pplayer,
+                                  const struct cityresult *result);
 
 static struct cityresult *cityresult_fill(struct ai_type *ait,
                                           struct player *pplayer,
@@ -202,9 +227,13 @@ static int result_defense_bonus(struct player *pplayer,
 static int naval_bonus(const struct cityresult *result);
 static void print_cityresult(struct player *pplayer,
                              const struct cityresult *cr);
-struct cityresult *city_desirability(struct ai_type *ait,
-                                     struct player *pplayer,
-                                     struct unit *punit, struct tile *ptile);
+static const struct cityresult *site_plr_get(struct ai_type *ait,
+                                             struct player *pplayer,
+                                             struct tile *ptile);
+static const struct cityresult *city_desirability(struct ai_type *ait,
+                                                  struct player *pplayer,
+                                                  struct unit *punit,
+                                                  struct tile *ptile);
 static struct cityresult *settler_map_iterate(struct ai_type *ait,
                                               struct pf_parameter *parameter,
                                               struct unit *punit,
@@ -249,6 +278,43 @@ static struct cityresult *cityresult_new(struct tile *ptile)
   return result;
 }
 
+/*************************************************************************//**
+  Make a copy of a city result, including its tile data.
+*****************************************************************************/
+static struct cityresult *cityresult_copy(const struct cityresult *result)
+{
+  struct cityresult *copy;
+
+  fc_assert_ret_val(result != NULL, NULL);
+
+  copy = fc_malloc(sizeof(*copy));
+  *copy = *result;
+  copy->city_center.tdc = NULL;
+  copy->best_other.tdc = NULL;
+  copy->tdc_hash = tile_data_cache_hash_new();
+
+  city_tile_iterate_index(result->city_radius_sq, result->tile, ptile,
+                          cindex) {
+    struct tile_data_cache *ptdc;
+    struct tile_data_cache *ptdc_copy;
+
+    if (!tile_data_cache_hash_lookup(result->tdc_hash, cindex, &ptdc)) {
+      continue;
+    }
+
+    ptdc_copy = tile_data_cache_copy(ptdc);
+    if (ptdc == result->city_center.tdc) {
+      copy->city_center.tdc = ptdc_copy;
+    }
+    if (ptdc == result->best_other.tdc) {
+      copy->best_other.tdc = ptdc_copy;
+    }
+    tile_data_cache_hash_insert(copy->tdc_hash, cindex, ptdc_copy);
+  } city_tile_iterate_index_end;
+
+  return copy;
+}
+
 /*************************************************************************//**
   Destroy a city result.
 *****************************************************************************/
@@ -262,6 +328,34 @@ static void cityresult_destroy(struct cityresult *result)
   }
 }
 
+/*************************************************************************//**
+  Check that the reservations and the availability of the tiles around
+  the city spot are still the ones cityresult_fill() saw. Tile outputs
+  are assumed to be constant for the turn, as in the tile data cache.
+*****************************************************************************/
+static bool cityresult_is_current(struct player *pplayer,
+                                  const struct cityresult *result)
+{
+  bool handicap = has_handicap(pplayer, H_MAP);
+
+  city_tile_iterate_index(result->city_radius_sq, result->tile, ptile,
+                          cindex) {
+    struct tile_data_cache *ptdc;
+    int reserved = citymap_read(ptile);
+    bool unavailable = (reserved < 0
+                        || (handicap && !map_is_known(ptile, pplayer))
+                        || NULL != tile_worked(ptile));
+
+    if (!tile_data_cache_hash_lookup(result->tdc_hash, cindex, &ptdc)
+        || ptdc->reserved != reserved
+        || (ptdc->sum < 0) != unavailable) {
+      return FALSE;
+    }
+  } city_tile_iterate_index_end;
+
+  return TRUE;
+}
+
 /*************************************************************************//**
   Fill cityresult struct with useful info about the city spot. It must
   contain valid x, y coordinates and total should be zero.
@@ -551,6 +645,78 @@ static void tdc_plr_set(struct ai_type *ait, struct player *plr, int tindex,
   tile_data_cache_hash_replace(ai->settler->tdc_hash, tindex, ptdc);
 }
 
+/*************************************************************************//**
+  Free resources allocated for site data cache
+*****************************************************************************/
+static void site_data_cache_destroy(struct site_data_cache *psdc)
+{
+  if (psdc) {
+    cityresult_destroy(psdc->cr);
+    free(psdc);
+  }
+}
+
+/*************************************************************************//**
+  Return the value of a city spot for the player, without the checks that
+  depend on the settler. Sites are evaluated at most once per turn as long
+  as the tiles around them stay untouched; every settler and every
+  contemplate_new_city() call of the player shares the result. The
+  returned city result is owned by the cache and stays valid until the
+  next call for the same tile.
+*****************************************************************************/
+static const struct cityresult *site_plr_get(struct ai_type *ait,
+                                             struct player *pplayer,
+                                             struct tile *ptile)
+{
+  struct ai_plr *ai = dai_plr_data_get(ait, pplayer, NULL);
+  struct site_data_cache *psdc;
+  struct cityresult *cr;
+
+  fc_assert_ret_val(ai != NULL, NULL);
+  fc_assert_ret_val(ai->settler != NULL, NULL);
+  fc_assert_ret_val(ai->settler->site_hash != NULL, NULL);
+
+  if (site_data_cache_hash_lookup(ai->settler->site_hash, tile_index(ptile),
+                                  &psdc)
+      && psdc->turn == game.info.turn
+      && NULL == tile_city(ptile)
+      && cityresult_is_current(pplayer, psdc->cr)) {
+#ifdef FREECIV_DEBUG
+    ai->settler->site_cache.hit++;
+#endif /* FREECIV_DEBUG */
+    return psdc->cr;
+  }
+
+#ifdef FREECIV_DEBUG
+  ai->settler->site_cache.miss++;
+#endif /* FREECIV_DEBUG */
+
+  cr = cityresult_fill(ait, pplayer, ptile); /* Burn CPU, burn! */
+  if (cr) {
+    cr->total += result_defense_bonus(pplayer, cr);
+    cr->total += naval_bonus(cr);
+
+    /* Add remaining points, which is our potential */
+    cr->total += cr->remaining;
+
+    fc_assert_action(cr->total >= 0, cityresult_destroy(cr); cr = NULL);
+  }
+
+  if (!cr) {
+    /* Failed to find a good spot; evaluate it again next time. */
+    site_data_cache_hash_remove(ai->settler->site_hash, tile_index(ptile));
+    return NULL;
+  }
+
+  psdc = fc_malloc(sizeof(*psdc));
+  psdc->cr = cr;
+  psdc->turn = game.info.turn;
+  site_data_cache_hash_replace(ai->settler->site_hash, tile_index(ptile),
+                               psdc);
+
+  return cr;
+}
+
 /*************************************************************************//**
   Check if a city on this location would starve.
 *****************************************************************************/
@@ -695,14 +861,17 @@ static void print_cityresult(struct player *pplayer,
 /*************************************************************************//**
   Calculates the desire for founding a new city at 'ptile'. The citymap
   ensures that we do not build cities too close to each other. Returns NULL
-  if no place was found.
+  if no place was found. The result is owned by the player's site cache,
+  see site_plr_get().
 *****************************************************************************/
-struct cityresult *city_desirability(struct ai_type *ait, struct player *pplayer,
-                                     struct unit *punit, struct tile *ptile)
+static const struct cityresult *city_desirability(struct ai_type *ait,
+                                                  struct player *pplayer,
+                                                  struct unit *punit,
+                                                  struct tile *ptile)
 {
   struct city *pcity = tile_city(ptile);
   struct adv_data *ai = adv_data_get(pplayer, NULL);
-  struct cityresult *cr = NULL;
+  const struct cityresult *cr = NULL;
 
   fc_assert_ret_val(punit, NULL);
   fc_assert_ret_val(pplayer, NULL);
@@ -740,7 +909,7 @@ struct cityresult *city_desirability(struct ai_type *ait, struct player *pplayer
     return NULL;
   }
 
-  cr = cityresult_fill(ait, pplayer, ptile); /* Burn CPU, burn! */
+  cr = site_plr_get(ait, pplayer, ptile);
   if (!cr) {
     /* Failed to find a good spot */
     return NULL;
@@ -749,18 +918,9 @@ struct cityresult *city_desirability(struct ai_type *ait, struct player *pplayer
   /*** Alright: Now consider building a new city ***/
 
   if (food_starvation(cr) || shield_starvation(cr)) {
-    cityresult_destroy(cr);
     return NULL;
   }
 
-  cr->total += result_defense_bonus(pplayer, cr);
-  cr->total += naval_bonus(cr);
-
-  /* Add remaining points, which is our potential */
-  cr->total += cr->remaining;
-
-  fc_assert_ret_val(cr->total >= 0, NULL); /* Does not frees cr! */
-
   return cr;
 }
 
@@ -780,14 +940,15 @@ static struct cityresult *settler_map_iterate(struct ai_type *ait,
                                               struct unit *punit,
                                               int boat_cost)
 {
-  struct cityresult *cr = NULL, *best = NULL;
+  const struct cityresult *cr;
+  struct cityresult *best = NULL;
   int best_turn = 0; /* Which turn we found the best fit */
   struct player *pplayer = unit_owner(punit);
   struct pf_map *pfm;
 
   pfm = pf_map_new(parameter);
   pf_map_move_costs_iterate(pfm, ptile, move_cost, FALSE) {
-    int turns;
+    int turns, result;
 
     if (boat_cost == 0 && unit_class_get(punit)->adv.sea_move == MOVE_NONE
         && tile_continent(ptile) != tile_continent(unit_tile(punit))) {
@@ -815,30 +976,26 @@ static struct cityresult *settler_map_iterate(struct ai_type *ait,
 
     /* This algorithm punishes long treks */
     turns = move_cost / parameter->move_rate;
-    cr->result = amortize(cr->total, PERFECTION * turns);
+    result = amortize(cr->total, PERFECTION * turns);
 
     /* Reduce want by settler cost. Easier than amortize, but still
      * weeds out very small wants. ie we create a threshold here. */
     /* We also penalise here for using a boat (either virtual or real)
      * it's crude but what isn't? */
-    cr->result -= unit_build_shield_cost_base(punit) + boat_cost;
+    result -= unit_build_shield_cost_base(punit) + boat_cost;
 
     /* Find best spot */
-    if ((!best && cr->result > 0)
-        || (best && cr->result > best->result)) {
+    if ((!best && result > 0)
+        || (best && result > best->result)) {
       /* Destroy the old 'best' value. */
       cityresult_destroy(best);
-      /* save the new 'best' value. */
-      best = cr;
-      cr = NULL;
+      /* save the new 'best' value; cr belongs to the site cache. */
+      best = cityresult_copy(cr);
+      best->result = result;
       best_turn = turns;
 
       log_debug("settler map search (search): (%d,%d) %d",
                 TILE_XY(best->tile), best->result);
-    } else {
-      /* Destroy the unused result. */
-      cityresult_destroy(cr);
-      cr = NULL;
     }
 
     /* Can we terminate early? We have a 'good enough' spot, and
@@ -996,12 +1153,15 @@ void dai_auto_settler_init(struct ai_plr *ai)
 
   ai->settler = fc_calloc(1, sizeof(*ai->settler));
   ai->settler->tdc_hash = tile_data_cache_hash_new();
+  ai->settler->site_hash = site_data_cache_hash_new();
 
 #ifdef FREECIV_DEBUG
   ai->settler->cache.hit = 0;
   ai->settler->cache.old = 0;
   ai->settler->cache.miss = 0;
   ai->settler->cache.save = 0;
+  ai->settler->site_cache.hit = 0;
+  ai->settler->site_cache.miss = 0;
 #endif /* FREECIV_DEBUG */
 }
 
@@ -1192,20 +1352,27 @@ void dai_auto_settler_reset(struct ai_type *ait, struct player *pplayer)
   fc_assert_ret(ai != NULL);
   fc_assert_ret(ai->settler != NULL);
   fc_assert_ret(ai->settler->tdc_hash != NULL);
+  fc_assert_ret(ai->settler->site_hash != NULL);
 
 #ifdef FREECIV_DEBUG
   log_debug("[aisettler cache for %s] save: %d, miss: %d, old: %d, hit: %d",
             player_name(pplayer), ai->settler->cache.save,
             ai->settler->cache.miss, ai->settler->cache.old,
             ai->settler->cache.hit);
+  log_debug("[aisettler site cache for %s] miss: %d, hit: %d",
+            player_name(pplayer), ai->settler->site_cache.miss,
+            ai->settler->site_cache.hit);
 
   ai->settler->cache.hit = 0;
   ai->settler->cache.old = 0;
   ai->settler->cache.miss = 0;
   ai->settler->cache.save = 0;
+  ai->settler->site_cache.hit = 0;
+  ai->settler->site_cache.miss = 0;
 #endif /* FREECIV_DEBUG */
 
   tile_data_cache_hash_clear(ai->settler->tdc_hash);
+  site_data_cache_hash_clear(ai->settler->site_hash);
 
   if (caller_closes) {
     dai_data_phase_finished(ait, pplayer);
@@ -1223,6 +1390,9 @@ void dai_auto_settler_free(struct ai_plr *ai)
     if (ai->settler->tdc_hash) {
       tile_data_cache_hash_destroy(ai->settler->tdc_hash);
     }
+    if (ai->settler->site_hash) {
+      site_data_cache_hash_destroy(ai->settler->site_hash);
+    }
     free(ai->settler);
   }
   ai->settler = NULL;
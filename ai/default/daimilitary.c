@@ -18,6 +18,7 @@
 #include <string.h>
 
 /* utility */
+#include "bitvector.h"
 #include "log.h"
 
 /* common */
@@ -69,6 +70,82 @@
 
 #include "daimilitary.h"
 
+/* Cities that units of one type, owner and move rate starting from one
+ * tile may reach within the given number of turns. */
+struct dai_reach {
+  const struct player *owner;
+  const struct unit_type *utype;
+  int move_rate;
+  int max_turns;
+  bool omniscient;
+  int diplomacy_serial;         /* Owner state it was found with; */
+  int knowledge_serial;         /* see struct dai_reach_owner. */
+  struct city_list *cities;
+};
+
+static void dai_reach_destroy(struct dai_reach *preach);
+
+#define SPECLIST_TAG dai_reach
+#define SPECLIST_TYPE struct dai_reach
+#include "speclist.h"
+#define dai_reach_list_iterate(reachlist, preach) \
+  TYPED_LIST_ITERATE(struct dai_reach, reachlist, preach)
+#define dai_reach_list_iterate_end LIST_ITERATE_END
+
+/* struct dai_reach_hash: reaches by start tile index. */
+#define SPECHASH_TAG dai_reach
+#define SPECHASH_INT_KEY_TYPE
+#define SPECHASH_IDATA_TYPE struct dai_reach_list *
+#define SPECHASH_IDATA_FREE dai_reach_list_destroy
+#include "spechash.h"
+#define dai_reach_hash_data_iterate(phash, reachlist) \
+  TYPED_HASH_DATA_ITERATE(struct dai_reach_list *, phash, reachlist)
+#define dai_reach_hash_data_iterate_end HASH_DATA_ITERATE_END
+
+/* What the reaches of the units of a player depend on, apart from the
+ * map itself. */
+struct dai_reach_owner {
+  bv_player allied;
+  bv_player at_war;
+  struct dbv known;
+  int diplomacy_serial;
+  int knowledge_serial;
+};
+
+/* The reaches do not depend on who is threatened, so they are shared by
+ * the threat fields of all players. The entries found in one world
+ * generation (see dai_threats_invalidate()) and phase are kept until the
+ * last threat field is closed, and are only dropped when the next one
+ * is opened. */
+static struct {
+  int refcount;                 /* Number of open threat fields. */
+  int generation;
+  int turn;
+  int phase;
+  const struct civ_map *map;
+  struct dbv near_cities;       /* City tiles and their neighbours. */
+  struct dai_reach_owner *owners;       /* By player index. */
+  struct dai_reach_hash *reach;
+#ifdef FREECIV_DEBUG
+  struct {
+    int hit;
+    int stale;
+    int miss;
+  } stats;
+#endif /* FREECIV_DEBUG */
+} reach_cache;
+
+static int world_generation = 0;
+
+/* Threat field of a player, shared by the danger assessment of all its
+ * cities; see dai_threats_begin(). */
+struct dai_threats {
+  int level;                    /* Nesting level of dai_threats_begin(). */
+  const struct civ_map *map;
+  int max_turns;
+  bool omniscient;
+};
+
 static unsigned int assess_danger(struct ai_type *ait, struct city *pcity,
                                   const struct civ_map *dmap,
                                   player_unit_list_getter ul_cb);
@@ -83,41 +160,52 @@ struct unit_type *dai_choose_defender_versus(struct city *pcity,
   double best = 0;
   int best_cost = FC_INFINITY;
   struct player *pplayer = city_owner(pcity);
+  struct virtual_defender defenders[U_LAST];
+  double costs[U_LAST];
+  int count = 0, attack, i;
 
   simple_ai_unit_type_iterate(punittype) {
     if (can_city_build_unit_now(pcity, punittype)) {
-      int fpatt, fpdef, defense, attack;
-      double want, loss, cost = utype_build_shield_cost(pcity, punittype);
-      struct unit *defender;
-      int veteran = get_unittype_bonus(city_owner(pcity), pcity->tile, punittype,
+      int veteran = get_unittype_bonus(pplayer, pcity->tile, punittype,
                                        EFT_VETERAN_BUILD);
 
-      defender = unit_virtual_create(pplayer, pcity, punittype, veteran);
-      defense = get_total_defense_power(attacker, defender);
-      attack = get_total_attack_power(attacker, defender);
-      get_modified_firepower(attacker, defender, &fpatt, &fpdef);
+      costs[count] = utype_build_shield_cost(pcity, punittype);
+      defenders[count].utype = punittype;
+      defenders[count].veteran = MIN(veteran,
+                                     utype_veteran_levels(punittype) - 1);
+      count++;
+    }
+  } simple_ai_unit_type_iterate_end;
+
+  /* All candidates face the same attacker on the same tile, so evaluate
+   * them in one go instead of building a virtual unit for each. */
+  attack = get_virtual_defenders_power(attacker, pplayer, pcity->tile,
+                                       defenders, count);
+
+  for (i = 0; i < count; i++) {
+    struct unit_type *punittype = defenders[i].utype;
+    double want, loss, cost = costs[i];
 
-      /* Greg's algorithm. loss is the average number of health lost by
-       * defender. If loss > attacker's hp then we should win the fight,
-       * which is always a good thing, since we avoid shield loss. */
-      loss = (double) defense * punittype->hp * fpdef / (attack * fpatt);
-      want = (loss + MAX(0, loss - attacker->hp)) / cost;
+    /* Greg's algorithm. loss is the average number of health lost by
+     * defender. If loss > attacker's hp then we should win the fight,
+     * which is always a good thing, since we avoid shield loss. */
+    loss = (double) defenders[i].defense * punittype->hp * defenders[i].def_fp
+      / (attack * defenders[i].att_fp);
+    want = (loss + MAX(0, loss - attacker->hp)) / cost;
 
 #ifdef NEVER
-      CITY_LOG(LOG_DEBUG, pcity, "desire for %s against %s(%d,%d) is %.2f",
-               unit_name_orig(punittype),
-               unit_name_orig(unit_type_get(attacker)), 
-               TILE_XY(attacker->tile), want);
+    CITY_LOG(LOG_DEBUG, pcity, "desire for %s against %s(%d,%d) is %.2f",
+             unit_name_orig(punittype),
+             unit_name_orig(unit_type_get(attacker)), 
+             TILE_XY(attacker->tile), want);
 #endif /* NEVER */
 
-      if (want > best || (want == best && cost <= best_cost)) {
-        best = want;
-        bestunit = punittype;
-        best_cost = cost;
-      }
-      unit_virtual_destroy(defender);
+    if (want > best || (want == best && cost <= best_cost)) {
+      best = want;
+      bestunit = punittype;
+      best_cost = cost;
     }
-  } simple_ai_unit_type_iterate_end;
+  }
 
   return bestunit;
 }
@@ -349,10 +437,343 @@ static int assess_defense_igwall(struct ai_type *ait, struct city *pcity)
 }
 
 /**********************************************************************//**
-  How dangerous and far a unit is for a city?
+  Number of turns ahead the danger assessment of the player looks.
+**************************************************************************/
+static int assess_danger_turns(struct player *pplayer)
+{
+  if (player_is_cpuhog(pplayer)) {
+    return 6;
+  }
+
+#ifdef FREECIV_WEB
+  return has_handicap(pplayer, H_ASSESS_DANGER_LIMITED) ? 2 : 3;
+#else
+  return 3;
+#endif
+}
+
+/**********************************************************************//**
+  Free a unit reach entry.
+**************************************************************************/
+static void dai_reach_destroy(struct dai_reach *preach)
+{
+  city_list_destroy(preach->cities);
+  free(preach);
+}
+
+/**********************************************************************//**
+  Drop all shared unit reaches.
+**************************************************************************/
+static void dai_reach_cache_flush(void)
+{
+#ifdef FREECIV_DEBUG
+  int entries = 0;
+  int cities = 0;
+
+  dai_reach_hash_data_iterate(reach_cache.reach, reachlist) {
+    entries += dai_reach_list_size(reachlist);
+    dai_reach_list_iterate(reachlist, preach) {
+      cities += city_list_size(preach->cities);
+    } dai_reach_list_iterate_end;
+  } dai_reach_hash_data_iterate_end;
+
+  /* Count three pointers per list link. */
+  log_debug("[threat reach cache] hit: %d, stale: %d, miss: %d, "
+            "%d entries listing %d cities in about %lu bytes",
+            reach_cache.stats.hit, reach_cache.stats.stale,
+            reach_cache.stats.miss, entries, cities,
+            (unsigned long) (entries * sizeof(struct dai_reach)
+                             + (entries + cities) * 3 * sizeof(void *)));
+  memset(&reach_cache.stats, 0, sizeof(reach_cache.stats));
+#endif /* FREECIV_DEBUG */
+
+  dai_reach_hash_clear(reach_cache.reach);
+}
+
+/**********************************************************************//**
+  Start using the shared unit reaches. If no threat field is open yet,
+  drop the reaches the world may have changed since, and note the owners
+  whose relations or map knowledge changed.
+**************************************************************************/
+static void dai_reach_cache_open(const struct civ_map *dmap)
+{
+  if (0 < reach_cache.refcount++) {
+    fc_assert(reach_cache.map == dmap);
+    return;
+  }
+
+  if (NULL == reach_cache.reach) {
+    reach_cache.reach = dai_reach_hash_new();
+    reach_cache.owners = fc_calloc(player_slot_count(),
+                                   sizeof(*reach_cache.owners));
+    dbv_init(&reach_cache.near_cities, MAP_INDEX_SIZE);
+    reach_cache.map = NULL;
+  }
+
+  if (reach_cache.generation != world_generation
+      || reach_cache.turn != game.info.turn
+      || reach_cache.phase != game.info.phase
+      || reach_cache.map != dmap) {
+    dai_reach_cache_flush();
+    reach_cache.generation = world_generation;
+    reach_cache.turn = game.info.turn;
+    reach_cache.phase = game.info.phase;
+    reach_cache.map = dmap;
+
+    dbv_clr_all(&reach_cache.near_cities);
+    cities_iterate(pcity) {
+      struct tile *ptile = city_tile(pcity);
+
+      dbv_set(&reach_cache.near_cities, tile_index(ptile));
+      adjc_iterate(dmap, ptile, adjc_tile) {
+        dbv_set(&reach_cache.near_cities, tile_index(adjc_tile));
+      } adjc_iterate_end;
+    } cities_iterate_end;
+  }
+
+  players_iterate(aplayer) {
+    struct dai_reach_owner *powner
+      = &reach_cache.owners[player_index(aplayer)];
+    bv_player allied, at_war;
+
+    BV_CLR_ALL(allied);
+    BV_CLR_ALL(at_war);
+    players_iterate(pother) {
+      if (pplayers_allied(aplayer, pother)) {
+        BV_SET(allied, player_index(pother));
+      }
+      if (pplayers_at_war(pother, aplayer)) {
+        BV_SET(at_war, player_index(pother));
+      }
+    } players_iterate_end;
+    if (!BV_ARE_EQUAL(allied, powner->allied)
+        || !BV_ARE_EQUAL(at_war, powner->at_war)) {
+      powner->allied = allied;
+      powner->at_war = at_war;
+      powner->diplomacy_serial++;
+    }
+
+    if (NULL == powner->known.vec
+        || !dbv_are_equal(&powner->known, &aplayer->tile_known)) {
+      dbv_free(&powner->known);
+      dbv_init(&powner->known, MAP_INDEX_SIZE);
+      dbv_or(&powner->known, &aplayer->tile_known);
+      powner->knowledge_serial++;
+    }
+  } players_iterate_end;
+}
+
+/**********************************************************************//**
+  Stop using the shared unit reaches.
+**************************************************************************/
+static void dai_reach_cache_close(void)
+{
+  fc_assert_ret(0 < reach_cache.refcount);
+
+  reach_cache.refcount--;
+}
+
+/**********************************************************************//**
+  Start using a threat field for the danger assessment of the cities of
+  pplayer. Instead of finding out by path-finding from every enemy unit
+  to every city whether the unit can reach the city in time, one
+  target-less map is iterated from each enemy unit up to the same move
+  cost limit as the per city reverse maps. Only the cities next to a tile
+  reached there can be reached by the unit, so only those still go
+  through the reverse map of the city.
+
+  The field is valid as long as no unit moves; calls may nest.
+**************************************************************************/
+void dai_threats_begin(struct ai_type *ait, struct player *pplayer,
+                       const struct civ_map *dmap)
+{
+  struct ai_plr *ai = def_ai_player_data(pplayer, ait);
+  struct dai_threats *threats = ai->threats;
+
+  if (NULL != threats) {
+    fc_assert(threats->map == dmap);
+    threats->level++;
+    return;
+  }
+
+  threats = fc_malloc(sizeof(*threats));
+  threats->level = 1;
+  threats->map = dmap;
+  threats->max_turns = assess_danger_turns(pplayer);
+  threats->omniscient = !has_handicap(pplayer, H_MAP);
+  dai_reach_cache_open(dmap);
+
+  ai->threats = threats;
+}
+
+/**********************************************************************//**
+  Stop using the threat field started by dai_threats_begin().
+**************************************************************************/
+void dai_threats_end(struct ai_type *ait, struct player *pplayer)
+{
+  struct ai_plr *ai = def_ai_player_data(pplayer, ait);
+  struct dai_threats *threats = ai->threats;
+
+  fc_assert_ret(NULL != threats);
+
+  if (0 < --threats->level) {
+    return;
+  }
+
+  dai_reach_cache_close();
+  free(threats);
+  ai->threats = NULL;
+}
+
+/**********************************************************************//**
+  Note that the world changed in a way that may change where units can
+  move, like terrain, cities, borders or transports. The unit reaches
+  shared by the threat fields are dropped when the next one is opened.
+**************************************************************************/
+void dai_threats_invalidate(void)
+{
+  world_generation++;
+}
+
+/**********************************************************************//**
+  Note that punit appeared or moved. Other units than transports do not
+  change where units can move by the rules of the reverse maps.
+**************************************************************************/
+void dai_threats_unit_moved(const struct unit *punit)
+{
+  if (0 < unit_type_get(punit)->transport_capacity) {
+    dai_threats_invalidate();
+  }
+}
+
+/**********************************************************************//**
+  Free the unit reaches shared by the threat fields.
+**************************************************************************/
+void dai_threats_free(void)
+{
+  if (NULL == reach_cache.reach) {
+    return;
+  }
+
+  fc_assert(0 == reach_cache.refcount);
+
+  dai_reach_cache_flush();
+  dai_reach_hash_destroy(reach_cache.reach);
+  reach_cache.reach = NULL;
+  dbv_free(&reach_cache.near_cities);
+  player_slots_iterate(pslot) {
+    dbv_free(&reach_cache.owners[player_slot_index(pslot)].known);
+  } player_slots_iterate_end;
+  free(reach_cache.owners);
+  reach_cache.owners = NULL;
+}
+
+/**********************************************************************//**
+  Return the cities that punit may reach within the danger assessment
+  horizon of the threat field. The parameters match the ones of the
+  reverse maps used by assess_danger(), except that no tile is the attack
+  target.
+**************************************************************************/
+static const struct city_list *dai_threats_reach(struct dai_threats *threats,
+                                                 const struct unit *punit)
+{
+  struct tile *start_tile = unit_tile(punit);
+  const struct player *owner = unit_owner(punit);
+  const struct unit_type *utype = unit_type_get(punit);
+  int move_rate = unit_move_rate(punit);
+  const struct dai_reach_owner *powner
+    = &reach_cache.owners[player_index(owner)];
+  struct dai_reach_list *reachlist;
+  struct dai_reach *preach = NULL;
+  struct pf_parameter parameter;
+  struct pf_map *pfm;
+  int max_cost;
+
+  if (!dai_reach_hash_lookup(reach_cache.reach, tile_index(start_tile),
+                             &reachlist)) {
+    reachlist = dai_reach_list_new_full(dai_reach_destroy);
+    dai_reach_hash_insert(reach_cache.reach, tile_index(start_tile),
+                          reachlist);
+  }
+
+  dai_reach_list_iterate(reachlist, known) {
+    if (known->owner == owner && known->utype == utype
+        && known->move_rate == move_rate
+        && known->max_turns == threats->max_turns
+        && known->omniscient == threats->omniscient) {
+      preach = known;
+      break;
+    }
+  } dai_reach_list_iterate_end;
+
+  if (NULL == preach) {
+#ifdef FREECIV_DEBUG
+    reach_cache.stats.miss++;
+#endif /* FREECIV_DEBUG */
+    preach = fc_malloc(sizeof(*preach));
+    preach->owner = owner;
+    preach->utype = utype;
+    preach->move_rate = move_rate;
+    preach->max_turns = threats->max_turns;
+    preach->omniscient = threats->omniscient;
+    preach->cities = city_list_new();
+    dai_reach_list_append(reachlist, preach);
+  } else if (preach->diplomacy_serial == powner->diplomacy_serial
+             && (preach->omniscient
+                 || preach->knowledge_serial == powner->knowledge_serial)) {
+#ifdef FREECIV_DEBUG
+    reach_cache.stats.hit++;
+#endif /* FREECIV_DEBUG */
+    return preach->cities;
+  } else {
+#ifdef FREECIV_DEBUG
+    reach_cache.stats.stale++;
+#endif /* FREECIV_DEBUG */
+    city_list_clear(preach->cities);
+  }
+  preach->diplomacy_serial = powner->diplomacy_serial;
+  preach->knowledge_serial = powner->knowledge_serial;
+
+  pft_fill_reverse_parameter(&parameter, NULL);
+  parameter.owner = owner;
+  parameter.omniscience = threats->omniscient;
+  parameter.map = threats->map;
+  parameter.start_tile = start_tile;
+  parameter.move_rate = move_rate;
+  parameter.moves_left_initially = move_rate;
+  parameter.utype = utype;
+
+  max_cost = move_rate * (threats->max_turns + 1);
+  pfm = pf_map_new(&parameter);
+  pf_map_move_costs_iterate(pfm, ptile, move_cost, TRUE) {
+    if (move_cost >= max_cost) {
+      break;
+    }
+    if (!dbv_isset(&reach_cache.near_cities, tile_index(ptile))) {
+      continue;
+    }
+
+    /* The city may be the attack target of a move from here. */
+    square_iterate(threats->map, ptile, 1, target_tile) {
+      struct city *pcity = tile_city(target_tile);
+
+      if (NULL != pcity && !city_list_search(preach->cities, pcity)) {
+        city_list_append(preach->cities, pcity);
+      }
+    } square_iterate_end;
+  } pf_map_move_costs_iterate_end;
+  pf_map_destroy(pfm);
+
+  return preach->cities;
+}
+
+/**********************************************************************//**
+  How dangerous and far a unit is for a city? If threats is not NULL, it
+  is used to skip the path-finding for units that cannot reach the city.
 **************************************************************************/
 static unsigned int assess_danger_unit(const struct city *pcity,
                                        struct pf_reverse_map *pcity_map,
+                                       struct dai_threats *threats,
                                        const struct unit *punit,
                                        int *move_time)
 {
@@ -371,7 +792,9 @@ static unsigned int assess_danger_unit(const struct city *pcity,
                   / punittype->paratroopers_range);
   }
 
-  if (pf_reverse_map_unit_position(pcity_map, punit, &pos)
+  if ((NULL == threats
+       || city_list_search(dai_threats_reach(threats, punit), pcity))
+      && pf_reverse_map_unit_position(pcity_map, punit, &pos)
       && (PF_IMPOSSIBLE_MC == *move_time
           || *move_time > pos.turn)) {
     *move_time = pos.turn;
@@ -379,6 +802,8 @@ static unsigned int assess_danger_unit(const struct city *pcity,
 
   if (unit_transported(punit)
       && (ferry = unit_transport_get(punit))
+      && (NULL == threats
+          || city_list_search(dai_threats_reach(threats, ferry), pcity))
       && pf_reverse_map_unit_position(pcity_map, ferry, &pos)) {
     if ((PF_IMPOSSIBLE_MC == *move_time
          || *move_time > pos.turn)) {
@@ -416,9 +841,11 @@ void dai_assess_danger_player(struct ai_type *ait, struct player *pplayer,
 {
   /* Do nothing if game is not running */
   if (S_S_RUNNING == server_state()) {
+    dai_threats_begin(ait, pplayer, dmap);
     city_list_iterate(pplayer->cities, pcity) {
       (void) assess_danger(ait, pcity, dmap, NULL);
     } city_list_iterate_end;
+    dai_threats_end(ait, pplayer);
   }
 }
 
@@ -494,9 +921,17 @@ static unsigned int assess_danger(struct ai_type *ait, struct city *pcity,
   bool defender_type_handled[U_LAST];
   int assess_turns;
   bool omnimap;
+  struct dai_threats *threats = def_ai_player_data(pplayer, ait)->threats;
 
   TIMING_LOG(AIT_DANGER, TIMER_START);
 
+  if (NULL != threats
+      && (NULL != ul_cb || threats->map != dmap
+          || !dbv_isset(&reach_cache.near_cities, tile_index(ptile)))) {
+    /* The threat field does not cover this assessment. */
+    threats = NULL;
+  }
+
   /* Initialize data. */
   memset(&danger_reduced, 0, sizeof(danger_reduced));
   if (has_handicap(pplayer, H_DANGER)) {
@@ -540,14 +975,7 @@ static unsigned int assess_danger(struct ai_type *ait, struct city *pcity,
     }
   } unit_list_iterate_end;
 
-  if (player_is_cpuhog(pplayer)) {
-    assess_turns = 6;
-  } else {
-    assess_turns = 3;
-#ifdef FREECIV_WEB
-    assess_turns = has_handicap(pplayer, H_ASSESS_DANGER_LIMITED) ? 2 : 3;
-#endif
-  }
+  assess_turns = assess_danger_turns(pplayer);
 
   omnimap = !has_handicap(pplayer, H_MAP);
 
@@ -597,7 +1025,7 @@ static unsigned int assess_danger(struct ai_type *ait, struct city *pcity,
         continue;
       }
 
-      vulnerability = assess_danger_unit(pcity, pcity_map,
+      vulnerability = assess_danger_unit(pcity, pcity_map, threats,
                                          punit, &move_time);
 
       if (PF_IMPOSSIBLE_MC == move_time) {
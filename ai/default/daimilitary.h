@@ -38,6 +38,12 @@ struct adv_choice *military_advisor_choose_build(struct ai_type *ait,
                                                  player_unit_list_getter ul_cb);
 void dai_assess_danger_player(struct ai_type *ait, struct player *pplayer,
                               const struct civ_map *dmap);
+void dai_threats_begin(struct ai_type *ait, struct player *pplayer,
+                       const struct civ_map *dmap);
+void dai_threats_end(struct ai_type *ait, struct player *pplayer);
+void dai_threats_invalidate(void);
+void dai_threats_unit_moved(const struct unit *punit);
+void dai_threats_free(void);
 int assess_defense_quadratic(struct ai_type *ait, struct city *pcity);
 int assess_defense_unit(struct ai_type *ait, struct city *pcity,
                         struct unit *punit, bool igwall);
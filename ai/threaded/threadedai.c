@@ -409,6 +409,15 @@ static void twai_switch_to_explore(struct unit *punit, struct tile *target,
   TAI_DFUNC(dai_switch_to_explore, punit, target, allow);
 }
 
+/**********************************************************************//**
+  Call default ai with threaded ai type as parameter.
+**************************************************************************/
+static void twai_phase_plan(struct player *pplayer)
+{
+  TAI_AIT;
+  TAI_DFUNC(dai_do_phase_plan, pplayer);
+}
+
 /**********************************************************************//**
   Call default ai with threaded ai type as parameter.
 **************************************************************************/
@@ -618,6 +627,7 @@ bool fc_ai_threaded_setup(struct ai_type *ai)
 
   ai->funcs.want_to_explore = twai_switch_to_explore;
 
+  ai->funcs.phase_plan = twai_phase_plan;
   ai->funcs.first_activities = twai_first_activities;
   ai->funcs.restart_phase = twai_restart_phase;
   ai->funcs.diplomacy_actions = twai_diplomacy_actions;
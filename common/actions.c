@@ -78,6 +78,13 @@ static bool actions_initialized = FALSE;
 
 static struct action_enabler_list *action_enablers_by_action[MAX_NUM_ACTIONS];
 
+/* The enablers of each action that a unit of each unit type may be able
+ * to use. The unit type's own unit type, unit class and their flags never
+ * change, so an enabler whose actor requirements about them are unmet is
+ * left out. Built on first use from action_enablers_by_action[]. */
+static struct action_enabler_list *
+action_enablers_by_utype[U_LAST][MAX_NUM_ACTIONS];
+
 /* Hard requirements relates to action result. */
 static struct obligatory_req_vector obligatory_hard_reqs[ACTION_COUNT];
 
@@ -90,6 +97,8 @@ static struct action *action_new(action_id id,
                                  const int max_distance,
                                  bool actor_consuming_always);
 
+static void action_enablers_by_utype_clear(action_id action);
+
 static bool is_enabler_active(const struct action_enabler *enabler,
 			      const struct player *actor_player,
 			      const struct city *actor_city,
@@ -725,6 +734,7 @@ void actions_free(void)
     } action_enabler_list_iterate_end;
 
     action_enabler_list_destroy(action_enablers_by_action[act]);
+    action_enablers_by_utype_clear(act);
 
     FC_FREE(actions[act]);
   } action_iterate_end;
@@ -1375,6 +1385,7 @@ void action_enabler_add(struct action_enabler *enabler)
   action_enabler_list_append(
         action_enablers_for_action(enabler->action),
         enabler);
+  action_enablers_by_utype_clear(enabler->action);
 }
 
 /**********************************************************************//**
@@ -1389,6 +1400,8 @@ bool action_enabler_remove(struct action_enabler *enabler)
   /* Sanity check: a non existing action doesn't have enablers. */
   fc_assert_ret_val(action_id_exists(enabler->action), FALSE);
 
+  action_enablers_by_utype_clear(enabler->action);
+
   return action_enabler_list_remove(
         action_enablers_for_action(enabler->action),
         enabler);
@@ -1406,6 +1419,90 @@ action_enablers_for_action(action_id action)
   return action_enablers_by_action[action];
 }
 
+/**********************************************************************//**
+  Returns TRUE iff an actor unit of the type putype may fulfill the actor
+  requirements of the enabler. Only looks at the requirements that are
+  fully decided by the unit type.
+**************************************************************************/
+static bool enabler_utype_may_match(const struct action_enabler *enabler,
+                                    const struct unit_type *putype)
+{
+  struct universal source = {
+    .kind = VUT_UTYPE,
+    .value = {.utype = putype}
+  };
+
+  requirement_vector_iterate(&enabler->actor_reqs, preq) {
+    if (preq->range != REQ_RANGE_LOCAL) {
+      /* Not evaluated against the actor unit type. */
+      continue;
+    }
+
+    switch (universal_fulfills_requirement(preq, &source)) {
+    case ITF_NOT_APPLICABLE:
+      break;
+    case ITF_NO:
+      if (preq->present) {
+        return FALSE;
+      }
+      break;
+    case ITF_YES:
+      if (!preq->present) {
+        return FALSE;
+      }
+      break;
+    }
+  } requirement_vector_iterate_end;
+
+  return TRUE;
+}
+
+/**********************************************************************//**
+  Get the enablers for an action that an actor unit of the type putype
+  may be able to use. A subset of action_enablers_for_action() that
+  leaves out the enablers that can't be active for this unit type.
+**************************************************************************/
+struct action_enabler_list *
+action_enablers_for_utype_action(const struct unit_type *putype,
+                                 action_id action)
+{
+  struct action_enabler_list **plist;
+
+  fc_assert_ret_val(putype != NULL, NULL);
+  fc_assert_ret_val(action_id_exists(action), NULL);
+
+  plist = &action_enablers_by_utype[utype_index(putype)][action];
+
+  if (*plist == NULL) {
+    *plist = action_enabler_list_new();
+
+    action_enabler_list_iterate(action_enablers_by_action[action],
+                                enabler) {
+      if (enabler_utype_may_match(enabler, putype)) {
+        action_enabler_list_append(*plist, enabler);
+      }
+    } action_enabler_list_iterate_end;
+  }
+
+  return *plist;
+}
+
+/**********************************************************************//**
+  Forget the per unit type enabler lists of the action. They are rebuilt
+  on demand by action_enablers_for_utype_action().
+**************************************************************************/
+static void action_enablers_by_utype_clear(action_id action)
+{
+  int i;
+
+  for (i = 0; i < U_LAST; i++) {
+    if (action_enablers_by_utype[i][action] != NULL) {
+      action_enabler_list_destroy(action_enablers_by_utype[i][action]);
+      action_enablers_by_utype[i][action] = NULL;
+    }
+  }
+}
+
 /**********************************************************************//**
   Returns an error message text if the action enabler is missing at least
   one of its action's obligatory hard requirement. Returns NULL if all
@@ -2837,7 +2934,10 @@ static bool is_action_enabled(const action_id wanted_action,
     return FALSE;
   }
 
-  action_enabler_list_iterate(action_enablers_for_action(wanted_action),
+  action_enabler_list_iterate((actor_unittype != NULL
+                               ? action_enablers_for_utype_action(
+                                   actor_unittype, wanted_action)
+                               : action_enablers_for_action(wanted_action)),
                               enabler) {
     if (is_enabler_active(enabler, actor_player, actor_city,
                           actor_building, actor_tile,
@@ -3243,7 +3343,10 @@ action_enabled_local(const action_id wanted_action,
   enum fc_tristate result;
 
   result = TRI_NO;
-  action_enabler_list_iterate(action_enablers_for_action(wanted_action),
+  action_enabler_list_iterate((actor_unit != NULL
+                               ? action_enablers_for_utype_action(
+                                   unit_type_get(actor_unit), wanted_action)
+                               : action_enablers_for_action(wanted_action)),
                               enabler) {
     current = fc_tristate_and(mke_eval_reqs(actor_player, actor_player,
                                             target_player, actor_city,
@@ -4766,7 +4869,8 @@ bool action_maybe_possible_actor_unit(const action_id act_id,
     return FALSE;
   }
 
-  action_enabler_list_iterate(action_enablers_for_action(act_id),
+  action_enabler_list_iterate(action_enablers_for_utype_action(
+                                actor_unittype, act_id),
                               enabler) {
     const enum fc_tristate current
         = mke_eval_reqs(actor_player,
@@ -501,6 +501,9 @@ const char *action_ui_name_default(int act);
 
 struct action_enabler_list *
 action_enablers_for_action(action_id action);
+struct action_enabler_list *
+action_enablers_for_utype_action(const struct unit_type *putype,
+                                 action_id action);
 
 struct action_enabler *action_enabler_new(void);
 void action_enabler_close(struct action_enabler *enabler);
@@ -24,7 +24,7 @@ extern "C" {
  * structure below. When changing mandatory capability part, check that
  * there's enough reserved_xx pointers in the end of the structure for
  * taking to use without need to bump mandatory capability again. */
-#define FC_AI_MOD_CAPSTR "+Freeciv-3.1-ai-module-2019.Feb.16"
+#define FC_AI_MOD_CAPSTR "+Freeciv-3.1-ai-module-2019.Mar.04"
 
 /* Timers for all AI activities. Define it to get statistics about the AI. */
 #ifdef FREECIV_DEBUG
@@ -244,6 +244,11 @@ struct ai_type
     void (*want_to_explore)(struct unit *punit, struct tile *target,
                             enum override_bool *allow);
 
+    /* Called for player AI type of every AI player in the phase before
+     * first_activities is called for any of them. All of them plan against
+     * the same world state, so this must not change it. */
+    void (*phase_plan)(struct player *pplayer);
+
     /* Called for player AI type in the beginning of player phase.
      * Unlike with phase_begin, everything is set up for phase already. */
     void (*first_activities)(struct player *pplayer);
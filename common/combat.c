@@ -320,19 +320,24 @@ double win_chance(int as, int ahp, int afp, int ds, int dhp, int dfp)
 }
 
 /*******************************************************************//**
-A unit's effective firepower depend on the situation.
+  Effective firepower of att_type attacking def_type at def_tile from
+  att_tile. defend_bonus is the EFT_DEFEND_BONUS the defender gets
+  against att_type; it only matters for UTYF_BADWALLATTACKER attackers.
 ***********************************************************************/
-void get_modified_firepower(const struct unit *attacker,
-			    const struct unit *defender,
-			    int *att_fp, int *def_fp)
+static void modified_firepower(const struct unit_type *att_type,
+                               const struct unit_type *def_type,
+                               const struct tile *att_tile,
+                               const struct tile *def_tile,
+                               int defend_bonus,
+                               int *att_fp, int *def_fp)
 {
-  struct city *pcity = tile_city(unit_tile(defender));
+  struct city *pcity = tile_city(def_tile);
 
-  *att_fp = unit_type_get(attacker)->firepower;
-  *def_fp = unit_type_get(defender)->firepower;
+  *att_fp = att_type->firepower;
+  *def_fp = def_type->firepower;
 
   /* Check CityBuster flag */
-  if (unit_has_type_flag(attacker, UTYF_CITYBUSTER) && pcity) {
+  if (utype_has_flag(att_type, UTYF_CITYBUSTER) && pcity) {
     *att_fp *= 2;
   }
 
@@ -341,16 +346,14 @@ void get_modified_firepower(const struct unit *attacker,
    * an EFT_DEFEND_BONUS applies (such as a land unit attacking a city with
    * city walls).
    */
-  if (unit_has_type_flag(attacker, UTYF_BADWALLATTACKER)
-      && get_unittype_bonus(unit_owner(defender), unit_tile(defender),
-                            unit_type_get(attacker), EFT_DEFEND_BONUS) > 0) {
+  if (utype_has_flag(att_type, UTYF_BADWALLATTACKER)
+      && defend_bonus > 0) {
     *att_fp = 1;
   }
 
   /* pearl harbour - defender's firepower is reduced to one, 
    *                 attacker's is multiplied by two         */
-  if (unit_has_type_flag(defender, UTYF_BADCITYDEFENDER)
-      && tile_city(unit_tile(defender))) {
+  if (utype_has_flag(def_type, UTYF_BADCITYDEFENDER) && pcity) {
     *att_fp *= 2;
     *def_fp = 1;
   }
@@ -359,21 +362,40 @@ void get_modified_firepower(const struct unit *attacker,
    * When attacked by fighters, helicopters have their firepower
    * reduced to 1.
    */
-  if (combat_bonus_against(unit_type_get(attacker)->bonuses,
-                           unit_type_get(defender),
+  if (combat_bonus_against(att_type->bonuses, def_type,
                            CBONUS_FIREPOWER1)) {
     *def_fp = 1;
   }
 
   /* In land bombardment both units have their firepower reduced to 1 */
-  if (!is_native_tile(unit_type_get(attacker), unit_tile(defender))
-      && !can_exist_at_tile(&(wld.map),
-                            unit_type_get(defender), unit_tile(attacker))) {
+  if (!is_native_tile(att_type, def_tile)
+      && !can_exist_at_tile(&(wld.map), def_type, att_tile)) {
     *att_fp = 1;
     *def_fp = 1;
   }
 }
 
+/*******************************************************************//**
+A unit's effective firepower depend on the situation.
+***********************************************************************/
+void get_modified_firepower(const struct unit *attacker,
+			    const struct unit *defender,
+			    int *att_fp, int *def_fp)
+{
+  const struct unit_type *att_type = unit_type_get(attacker);
+  int defend_bonus = 0;
+
+  if (utype_has_flag(att_type, UTYF_BADWALLATTACKER)) {
+    defend_bonus = get_unittype_bonus(unit_owner(defender),
+                                      unit_tile(defender), att_type,
+                                      EFT_DEFEND_BONUS);
+  }
+
+  modified_firepower(att_type, unit_type_get(defender),
+                     unit_tile(attacker), unit_tile(defender),
+                     defend_bonus, att_fp, def_fp);
+}
+
 /*******************************************************************//**
 Returns a double in the range [0;1] indicating the attackers chance of
 winning. The calculation takes all factors into account.
@@ -455,31 +477,40 @@ int base_get_attack_power(const struct unit_type *punittype,
 }
 
 /*******************************************************************//**
-  Returns the defense power, modified by veteran status.
+  Returns the defense power of a unit of the given type, modified by
+  veteran status.
 ***********************************************************************/
-int base_get_defense_power(const struct unit *punit)
+static int utype_base_defense_power(const struct unit_type *punittype,
+                                    int veteran)
 {
   const struct veteran_level *vlevel;
 
-  fc_assert_ret_val(punit != NULL, 0);
-
-  vlevel = utype_veteran_level(unit_type_get(punit), punit->veteran);
+  vlevel = utype_veteran_level(punittype, veteran);
   fc_assert_ret_val(vlevel != NULL, 0);
 
-  return unit_type_get(punit)->defense_strength * POWER_FACTOR
+  return punittype->defense_strength * POWER_FACTOR
          * vlevel->power_fact / 100;
 }
 
 /*******************************************************************//**
-  Returns the defense power, modified by terrain and veteran status.
-  Note that rivers as special road types are not handled here as
-  terrain property.
+  Returns the defense power, modified by veteran status.
 ***********************************************************************/
-static int get_defense_power(const struct unit *punit)
+int base_get_defense_power(const struct unit *punit)
 {
-  int db, power = base_get_defense_power(punit);
-  struct tile *ptile = unit_tile(punit);
-  struct unit_class *pclass = unit_class_get(punit);
+  fc_assert_ret_val(punit != NULL, 0);
+
+  return utype_base_defense_power(unit_type_get(punit), punit->veteran);
+}
+
+/*******************************************************************//**
+  Returns the defense power of a unit of the given type standing at
+  ptile, modified by terrain and veteran status.
+***********************************************************************/
+static int utype_defense_power(const struct unit_type *punittype,
+                               int veteran, const struct tile *ptile)
+{
+  int db, power = utype_base_defense_power(punittype, veteran);
+  struct unit_class *pclass = utype_class(punittype);
 
   if (uclass_has_flag(pclass, UCF_TERRAIN_DEFENSE)) {
     db = 100 + tile_terrain(ptile)->defense_bonus;
@@ -493,6 +524,17 @@ static int get_defense_power(const struct unit *punit)
   return power;
 }
 
+/*******************************************************************//**
+  Returns the defense power, modified by terrain and veteran status.
+  Note that rivers as special road types are not handled here as
+  terrain property.
+***********************************************************************/
+static int get_defense_power(const struct unit *punit)
+{
+  return utype_defense_power(unit_type_get(punit), punit->veteran,
+                             unit_tile(punit));
+}
+
 /*******************************************************************//**
   Return the modified attack power of a unit.
 ***********************************************************************/
@@ -509,20 +551,16 @@ int get_total_attack_power(const struct unit *attacker,
 }
 
 /*******************************************************************//**
- Return an increased defensepower. Effects which increase the
- defensepower are:
-  - unit type effects (horse vs pikemen for example)
-  - defender in a fortress
-  - fortified defender
-
-May be called with a non-existing att_type to avoid any unit type
-effects.
+  As defense_multiplication(), with the EFT_DEFEND_BONUS the defender
+  gets against att_type already known. That bonus depends only on the
+  defending player, the tile and att_type, so callers evaluating several
+  defender types against one attacker look it up once.
 ***********************************************************************/
-static int defense_multiplication(const struct unit_type *att_type,
-                                  const struct unit_type *def_type,
-                                  const struct player *def_player,
-                                  const struct tile *ptile,
-                                  int defensepower, bool fortified)
+static int defense_multiplication_bonus(const struct unit_type *att_type,
+                                        const struct unit_type *def_type,
+                                        const struct tile *ptile,
+                                        int defensepower, bool fortified,
+                                        int defend_bonus)
 {
   struct city *pcity = tile_city(ptile);
   int mod;
@@ -535,9 +573,7 @@ static int defense_multiplication(const struct unit_type *att_type,
 
     defensepower *= defense_multiplier;
 
-    /* This applies even if pcity is NULL. */
-    mod = 100 + get_unittype_bonus(def_player, ptile,
-                                   att_type, EFT_DEFEND_BONUS);
+    mod = 100 + defend_bonus;
     defensepower = MAX(0, defensepower * mod / 100);
 
     defense_divider = 1 + combat_bonus_against(att_type->bonuses, def_type,
@@ -557,6 +593,35 @@ static int defense_multiplication(const struct unit_type *att_type,
   return defensepower;
 }
 
+/*******************************************************************//**
+ Return an increased defensepower. Effects which increase the
+ defensepower are:
+  - unit type effects (horse vs pikemen for example)
+  - defender in a fortress
+  - fortified defender
+
+May be called with a non-existing att_type to avoid any unit type
+effects.
+***********************************************************************/
+static int defense_multiplication(const struct unit_type *att_type,
+                                  const struct unit_type *def_type,
+                                  const struct player *def_player,
+                                  const struct tile *ptile,
+                                  int defensepower, bool fortified)
+{
+  int defend_bonus = 0;
+
+  if (NULL != att_type) {
+    /* This applies even if there's no city at ptile. */
+    defend_bonus = get_unittype_bonus(def_player, ptile,
+                                      att_type, EFT_DEFEND_BONUS);
+  }
+
+  return defense_multiplication_bonus(att_type, def_type, ptile,
+                                      defensepower, fortified,
+                                      defend_bonus);
+}
+
 /*******************************************************************//**
  May be called with a non-existing att_type to avoid any effects which
  depend on the attacker.
@@ -634,6 +699,46 @@ int get_fortified_defense_power(const struct unit *attacker,
                                 TRUE);
 }
 
+/*******************************************************************//**
+  Evaluate attacker against count freshly built, unfortified units of the
+  types in defenders[] owned by def_player and standing at ptile. Fills
+  in the defense power and both firepowers of each entry the same way
+  get_total_defense_power() and get_modified_firepower() would for such
+  a unit, and returns get_total_attack_power() of the attacker, which is
+  the same against all of them.
+
+  The effect lookups that only depend on the attacker are done once for
+  the whole batch instead of once per defender type.
+***********************************************************************/
+int get_virtual_defenders_power(const struct unit *attacker,
+                                const struct player *def_player,
+                                const struct tile *ptile,
+                                struct virtual_defender *defenders,
+                                int count)
+{
+  const struct unit_type *att_type = unit_type_get(attacker);
+  int defend_bonus = get_unittype_bonus(def_player, ptile, att_type,
+                                        EFT_DEFEND_BONUS);
+  int attack_bonus = get_unittype_bonus(unit_owner(attacker), ptile,
+                                        att_type, EFT_ATTACK_BONUS);
+  int i;
+
+  for (i = 0; i < count; i++) {
+    struct virtual_defender *pdef = &defenders[i];
+
+    pdef->defense
+      = defense_multiplication_bonus(att_type, pdef->utype, ptile,
+                                     utype_defense_power(pdef->utype,
+                                                         pdef->veteran,
+                                                         ptile),
+                                     FALSE, defend_bonus);
+    modified_firepower(att_type, pdef->utype, unit_tile(attacker), ptile,
+                       defend_bonus, &pdef->att_fp, &pdef->def_fp);
+  }
+
+  return get_attack_power(attacker) * (100 + attack_bonus) / 100;
+}
+
 /*******************************************************************//**
 A number indicating the defense strength.
 Unlike the one got from win chance this doesn't potentially get insanely
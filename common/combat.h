@@ -75,6 +75,22 @@ int get_virtual_defense_power(const struct unit_type *attacker,
 int get_total_attack_power(const struct unit *attacker,
 			   const struct unit *defender);
 
+/* A unit type the defender could have, and how it fares against one
+ * attacker. See get_virtual_defenders_power(). */
+struct virtual_defender {
+  struct unit_type *utype;
+  int veteran;
+
+  int defense;
+  int att_fp, def_fp;
+};
+
+int get_virtual_defenders_power(const struct unit *attacker,
+                                const struct player *def_player,
+                                const struct tile *ptile,
+                                struct virtual_defender *defenders,
+                                int count);
+
 struct unit *get_defender(const struct unit *attacker,
 			  const struct tile *ptile);
 struct unit *get_attacker(const struct unit *defender,
@@ -100,19 +100,25 @@ void connection_close(struct connection *pconn, const char *reason)
 /**********************************************************************//**
   Make sure that there is at least extra_space bytes free space in buffer,
   allocating more memory if needed.
+
+  The buffer grows geometrically (up to MAX_LEN_BUFFER), so that queueing
+  many small packets to a slow connection does not reallocate the whole
+  buffer for every packet.
 **************************************************************************/
 static bool buffer_ensure_free_extra_space(struct socket_packet_buffer *buf,
 					   int extra_space)
 {
   /* room for more? */
   if (buf->nsize - buf->ndata < extra_space) {
-    buf->nsize = buf->ndata + extra_space;
+    int new_size = buf->ndata + extra_space;
 
     /* added this check so we don't gobble up too much mem */
-    if (buf->nsize > MAX_LEN_BUFFER) {
+    if (new_size > MAX_LEN_BUFFER) {
       return FALSE;
     }
-    buf->data = (unsigned char *) fc_realloc(buf->data, buf->nsize);
+    new_size = MAX(new_size, MIN(buf->nsize * 2, MAX_LEN_BUFFER));
+    buf->data = (unsigned char *) fc_realloc(buf->data, new_size);
+    buf->nsize = new_size;
   }
   return TRUE;
 }
@@ -195,7 +201,9 @@ static int write_socket_data(struct connection *pc,
     }
 
     if (FD_ISSET(pc->sock, &writefs)) {
-      nblock=MIN(buf->ndata-start, MAX_LEN_PACKET);
+      /* Hand everything pending to the kernel at once; a partial write
+       * just leaves the rest for the next round. */
+      nblock = buf->ndata - start;
       log_debug("trying to write %d limit=%d", nblock, limit);
       if ((nput = fc_writesocket(pc->sock, 
                                  (const char *)buf->data+start, nblock)) == -1) {
@@ -603,6 +611,7 @@ void connection_common_init(struct connection *pconn)
 #ifdef USE_COMPRESSION
   byte_vector_init(&pconn->compression.queue);
   pconn->compression.frozen_level = 0;
+  pconn->compression.capture = NULL;
 #endif
 }
 
@@ -272,6 +272,10 @@ struct connection {
     int frozen_level;
 
     struct byte_vector queue;
+
+    /* If set, encoded packets are collected here instead of being
+     * sent. See conn_compression_capture(). */
+    struct byte_vector *capture;
   } compression;
 #endif
   struct {
@@ -312,6 +316,15 @@ bool conn_compression_thaw(struct connection *pconn);
 bool conn_compression_frozen(const struct connection *pconn);
 void conn_list_compression_freeze(const struct conn_list *pconn_list);
 void conn_list_compression_thaw(const struct conn_list *pconn_list);
+#ifdef USE_COMPRESSION
+void conn_compression_capture(struct connection *pconn,
+                              struct byte_vector *capture);
+void compress_packet_stream(const unsigned char *data, size_t len,
+                            struct byte_vector *out);
+bool conn_compression_send_compressed(struct connection *pconn,
+                                      const unsigned char *data,
+                                      size_t len);
+#endif /* USE_COMPRESSION */
 
 const char *conn_description(const struct connection *pconn);
 bool conn_controls_player(const struct connection *pconn);
@@ -67,6 +67,13 @@
 
 #define MAX_DECOMPRESSION 400
 
+/*
+ * Keep this a decent amount less than MAX_LEN_BUFFER to avoid the
+ * (remote) possibility of trying to dump MAX_LEN_BUFFER to the
+ * network in one go
+ */
+#define MAX_LEN_COMPRESS_QUEUE (MAX_LEN_BUFFER/2)
+
 #endif /* USE_COMPRESSION */
 
 /* 
@@ -110,74 +117,167 @@ static inline int get_compression_level(void)
 }
 
 /**********************************************************************//**
-  Send all waiting data. Return TRUE on success.
+  Compress 'size' bytes of encoded packets and append the result to 'out',
+  framed as a compressed (or jumbo) packet. If compression would not make
+  the data smaller, the packets are appended unchanged instead.
 **************************************************************************/
-static bool conn_compression_flush(struct connection *pconn)
+static void compress_packet_data(const unsigned char *data, size_t size,
+                                 struct byte_vector *out)
 {
   int compression_level = get_compression_level();
-  uLongf compressed_size = 12 + 1.001 * pconn->compression.queue.size;
+  uLongf compressed_size = 12 + 1.001 * size;
+  size_t old_size = byte_vector_size(out);
+  unsigned char *frame;
   int error;
-  Bytef compressed[compressed_size];
   bool jumbo;
   unsigned long compressed_packet_len;
 
-  error = compress2(compressed, &compressed_size,
-                    pconn->compression.queue.p,
-                    pconn->compression.queue.size,
+  /* Compress behind room for the largest (jumbo) header. */
+  byte_vector_reserve(out, old_size + 6 + compressed_size);
+  frame = out->p + old_size;
+  error = compress2(frame + 6, &compressed_size, data, size,
                     compression_level);
-  fc_assert_ret_val(error == Z_OK, FALSE);
-
-  /* Compression signalling currently assumes a 2-byte packet length; if that
-   * changes, the protocol should probably be changed */
-  fc_assert_ret_val(data_type_size(pconn->packet_header.length) == 2, FALSE);
+  fc_assert_action(error == Z_OK, compressed_size = size);
 
   /* Include normal length field in decision */
   jumbo = (compressed_size+2 >= JUMBO_BORDER);
 
   compressed_packet_len = compressed_size + (jumbo ? 6 : 2);
-  if (compressed_packet_len < pconn->compression.queue.size) {
+  if (error == Z_OK && compressed_packet_len < size) {
     struct raw_data_out dout;
 
     log_compress("COMPRESS: compressed %lu bytes to %ld (level %d)",
-                 (unsigned long) pconn->compression.queue.size,
-                 compressed_size, compression_level);
-    stat_size_uncompressed += pconn->compression.queue.size;
+                 (unsigned long) size, compressed_size, compression_level);
+    stat_size_uncompressed += size;
     stat_size_compressed += compressed_size;
 
     if (!jumbo) {
-      unsigned char header[2];
       FC_STATIC_ASSERT(COMPRESSION_BORDER > MAX_LEN_PACKET,
                        uncompressed_compressed_packet_len_overlap);
 
       log_compress("COMPRESS: sending %ld as normal", compressed_size);
 
-      dio_output_init(&dout, header, sizeof(header));
+      memmove(frame + 2, frame + 6, compressed_size);
+      dio_output_init(&dout, frame, 2);
       dio_put_uint16_raw(&dout, 2 + compressed_size + COMPRESSION_BORDER);
-      connection_send_data(pconn, header, sizeof(header));
-      connection_send_data(pconn, compressed, compressed_size);
     } else {
-      unsigned char header[6];
       FC_STATIC_ASSERT(JUMBO_SIZE >= JUMBO_BORDER+COMPRESSION_BORDER,
                        compressed_normal_jumbo_packet_len_overlap);
 
       log_compress("COMPRESS: sending %ld as jumbo", compressed_size);
-      dio_output_init(&dout, header, sizeof(header));
+      dio_output_init(&dout, frame, 6);
       dio_put_uint16_raw(&dout, JUMBO_SIZE);
       dio_put_uint32_raw(&dout, 6 + compressed_size);
-      connection_send_data(pconn, header, sizeof(header));
-      connection_send_data(pconn, compressed, compressed_size);
     }
+    byte_vector_reserve(out, old_size + compressed_packet_len);
   } else {
     log_compress("COMPRESS: would enlarge %lu bytes to %ld; "
                  "sending uncompressed",
-                 (unsigned long) pconn->compression.queue.size,
-                 compressed_packet_len);
-    connection_send_data(pconn, pconn->compression.queue.p,
-                         pconn->compression.queue.size);
-    stat_size_no_compression += pconn->compression.queue.size;
+                 (unsigned long) size, compressed_packet_len);
+    memcpy(frame, data, size);
+    byte_vector_reserve(out, old_size + size);
+    stat_size_no_compression += size;
   }
+}
+
+/**********************************************************************//**
+  Send all waiting data. Return TRUE on success.
+**************************************************************************/
+static bool conn_compression_flush(struct connection *pconn)
+{
+  struct byte_vector frame;
+
+  /* Compression signalling currently assumes a 2-byte packet length; if that
+   * changes, the protocol should probably be changed */
+  fc_assert_ret_val(data_type_size(pconn->packet_header.length) == 2, FALSE);
+
+  byte_vector_init(&frame);
+  compress_packet_data(pconn->compression.queue.p,
+                       pconn->compression.queue.size, &frame);
+  connection_send_data(pconn, frame.p, frame.size);
+  byte_vector_free(&frame);
+
   return pconn->used;
 }
+
+/**********************************************************************//**
+  Return the length of the longest run of whole packets at the start of
+  'data' that fits in 'limit' bytes, but at least one packet.
+**************************************************************************/
+static size_t packet_stream_chunk_len(const unsigned char *data, size_t len,
+                                      size_t limit)
+{
+  size_t chunk = 0;
+
+  while (chunk < len) {
+    struct data_in din;
+    int packet_len;
+
+    dio_input_init(&din, data + chunk, len - chunk);
+    if (!dio_get_uint16_raw(&din, &packet_len) || 0 >= packet_len) {
+      /* Not a packet stream we understand; keep the rest together. */
+      return len;
+    }
+    if (0 < chunk && chunk + packet_len > limit) {
+      break;
+    }
+    chunk += packet_len;
+  }
+
+  return MIN(chunk, len);
+}
+
+/**********************************************************************//**
+  Compress a stream of already encoded packets, as produced while
+  capturing with conn_compression_capture(), into 'out'. The result can be
+  sent to any number of connections with conn_compression_send_compressed()
+  without compressing it again.
+**************************************************************************/
+void compress_packet_stream(const unsigned char *data, size_t len,
+                            struct byte_vector *out)
+{
+  while (0 < len) {
+    size_t chunk = packet_stream_chunk_len(data, len,
+                                           MAX_LEN_COMPRESS_QUEUE);
+
+    compress_packet_data(data, chunk, out);
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+/**********************************************************************//**
+  Start collecting the encoded packets sent to the connection in
+  'capture' instead of sending them, or stop it if 'capture' is NULL.
+  Captured packets can be sent later with
+  conn_compression_send_compressed(), after compress_packet_stream().
+**************************************************************************/
+void conn_compression_capture(struct connection *pconn,
+                              struct byte_vector *capture)
+{
+  pconn->compression.capture = capture;
+}
+
+/**********************************************************************//**
+  Send a packet stream compressed with compress_packet_stream() to the
+  connection. Packets already waiting in the compression queue are
+  flushed first, so the order of packets is kept. Returns TRUE on
+  success.
+**************************************************************************/
+bool conn_compression_send_compressed(struct connection *pconn,
+                                      const unsigned char *data,
+                                      size_t len)
+{
+  if (conn_compression_frozen(pconn)
+      && 0 < byte_vector_size(&pconn->compression.queue)) {
+    if (!conn_compression_flush(pconn)) {
+      return FALSE;
+    }
+    byte_vector_reserve(&pconn->compression.queue, 0);
+  }
+
+  return connection_send_data(pconn, data, len);
+}
 #endif /* USE_COMPRESSION */
 
 /**********************************************************************//**
@@ -230,13 +330,15 @@ int send_packet_data(struct connection *pc, unsigned char *data, int len,
   if (TRUE) {
     int size = len;
 
-    if (conn_compression_frozen(pc)) {
+    if (NULL != pc->compression.capture) {
+      size_t old_size = byte_vector_size(pc->compression.capture);
+
+      byte_vector_reserve(pc->compression.capture, old_size + len);
+      memcpy(pc->compression.capture->p + old_size, data, len);
+      log_compress2("COMPRESS: capturing %s", packet_name(packet_type));
+    } else if (conn_compression_frozen(pc)) {
       size_t old_size;
 
-      /* Keep this a decent amount less than MAX_LEN_BUFFER to avoid the
-       * (remote) possibility of trying to dump MAX_LEN_BUFFER to the
-       * network in one go */
-#define MAX_LEN_COMPRESS_QUEUE (MAX_LEN_BUFFER/2)
       FC_STATIC_ASSERT(MAX_LEN_COMPRESS_QUEUE < MAX_LEN_BUFFER,
                        compress_queue_maxlen_too_big);
 
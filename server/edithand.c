@@ -143,6 +143,7 @@ static void check_edited_tile_terrains(void)
 {
   if (need_continents_reassigned) {
     assign_continent_numbers();
+    map_borders_invalidate();
     send_all_known_tiles(NULL);
     need_continents_reassigned = FALSE;
   }
@@ -32,7 +32,7 @@ int hmap_shore_level = 0, hmap_mountain_level = 0;
 /**********************************************************************//**
   Factor by which to lower height map near poles in normalize_hmap_poles
 **************************************************************************/
-static float hmap_pole_factor(struct tile *ptile)
+static float hmap_pole_factor(struct tile *ptile, int colatitude)
 {
   float factor = 1.0;
 
@@ -43,11 +43,11 @@ static float hmap_pole_factor(struct tile *ptile)
   } else if (wld.map.server.flatpoles > 0) {
     /* Linear ramp down from 100% at 2.5*ICE_BASE_LEVEL to (100-flatpoles) %
      * at the poles */
-    factor = 1 - ((1 - (map_colatitude(ptile) / (2.5 * ICE_BASE_LEVEL)))
+    factor = 1 - ((1 - (colatitude / (2.5 * ICE_BASE_LEVEL)))
                   * wld.map.server.flatpoles / 100);
   }
   if (wld.map.server.separatepoles
-      && map_colatitude(ptile) >= 2 * ICE_BASE_LEVEL) {
+      && colatitude >= 2 * ICE_BASE_LEVEL) {
     /* A band of low height to try to separate the pole (this function is
      * only assumed to be called <= 2.5*ICE_BASE_LEVEL) */
     factor = MIN(factor, 0.1);
@@ -64,8 +64,10 @@ static float hmap_pole_factor(struct tile *ptile)
 void normalize_hmap_poles(void)
 {
   whole_map_iterate(&(wld.map), ptile) {
-    if (map_colatitude(ptile) <= 2.5 * ICE_BASE_LEVEL) {
-      hmap(ptile) *= hmap_pole_factor(ptile);
+    int colatitude = map_colatitude(ptile);
+
+    if (colatitude <= 2.5 * ICE_BASE_LEVEL) {
+      hmap(ptile) *= hmap_pole_factor(ptile, colatitude);
     } else if (near_singularity(ptile)) {
       /* Near map edge but not near pole. */
       hmap(ptile) = 0;
@@ -80,10 +82,13 @@ void normalize_hmap_poles(void)
 void renormalize_hmap_poles(void)
 {
   whole_map_iterate(&(wld.map), ptile) {
+    int colatitude;
+
     if (hmap(ptile) == 0) {
       /* Nothing left to restore. */
-    } else if (map_colatitude(ptile) <= 2.5 * ICE_BASE_LEVEL) {
-      float factor = hmap_pole_factor(ptile);
+    } else if ((colatitude = map_colatitude(ptile))
+               <= 2.5 * ICE_BASE_LEVEL) {
+      float factor = hmap_pole_factor(ptile, colatitude);
 
       if (factor > 0) {
         /* Invert the previously applied function */
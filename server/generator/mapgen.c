@@ -900,6 +900,7 @@ static void make_rivers(void)
   struct terrain *pterrain;
   struct river_map rivermap;
   struct extra_type *road_river = NULL;
+  struct dbv *road_tiles;
 
   /* Formula to make the river density similar om different sized maps. Avoids
      too few rivers on large maps and too many rivers on small maps. */
@@ -933,6 +934,20 @@ static void make_rivers(void)
   dbv_init(&rivermap.blocked, MAP_INDEX_SIZE);
   dbv_init(&rivermap.ok, MAP_INDEX_SIZE);
 
+  /* Tiles having each road type. Kept up to date as rivers are added, so
+   * the blocked map of each new river needs no whole map scans. */
+  road_tiles = fc_calloc(game.control.num_extra_types, sizeof(*road_tiles));
+  extra_type_by_cause_iterate(EC_ROAD, proad) {
+    struct dbv *ptiles = &road_tiles[extra_index(proad)];
+
+    dbv_init(ptiles, MAP_INDEX_SIZE);
+    whole_map_iterate(&(wld.map), rtile) {
+      if (tile_has_extra(rtile, proad)) {
+        dbv_set(ptiles, tile_index(rtile));
+      }
+    } whole_map_iterate_end;
+  } extra_type_by_cause_iterate_end;
+
   /* The main loop in this function. */
   while (current_riverlength < desirable_riverlength
 	 && iteration_counter < RIVERS_MAXTRIES) {
@@ -987,11 +1002,7 @@ static void make_rivers(void)
 
       extra_type_by_cause_iterate(EC_ROAD, oriver) {
         if (oriver != road_river) {
-          whole_map_iterate(&(wld.map), rtile) {
-            if (tile_has_extra(rtile, oriver)) {
-              dbv_set(&rivermap.blocked, tile_index(rtile));
-            }
-          } whole_map_iterate_end;
+          dbv_or(&rivermap.blocked, &road_tiles[extra_index(oriver)]);
         }
       } extra_type_by_cause_iterate_end;
 
@@ -1000,24 +1011,24 @@ static void make_rivers(void)
 
       /* Try to make a river. If it is OK, apply it to the map. */
       if (make_river(&rivermap, ptile, road_river)) {
-        whole_map_iterate(&(wld.map), ptile1) {
-          if (dbv_isset(&rivermap.ok, tile_index(ptile1))) {
-            struct terrain *river_terrain = tile_terrain(ptile1);
-
-            if (!terrain_has_flag(river_terrain, TER_CAN_HAVE_RIVER)) {
-              /* We have to change the terrain to put a river here. */
-              river_terrain = pick_terrain_by_flag(TER_CAN_HAVE_RIVER);
-              if (river_terrain != NULL) {
-                tile_set_terrain(ptile1, river_terrain);
-              }
+        dbv_iterate_set(&rivermap.ok, river_index) {
+          struct tile *ptile1 = index_to_tile(&(wld.map), river_index);
+          struct terrain *river_terrain = tile_terrain(ptile1);
+
+          if (!terrain_has_flag(river_terrain, TER_CAN_HAVE_RIVER)) {
+            /* We have to change the terrain to put a river here. */
+            river_terrain = pick_terrain_by_flag(TER_CAN_HAVE_RIVER);
+            if (river_terrain != NULL) {
+              tile_set_terrain(ptile1, river_terrain);
             }
-
-            tile_add_extra(ptile1, road_river);
-            current_riverlength++;
-            map_set_placed(ptile1);
-            log_debug("Applied a river to (%d, %d).", TILE_XY(ptile1));
           }
-        } whole_map_iterate_end;
+
+          tile_add_extra(ptile1, road_river);
+          dbv_set(&road_tiles[extra_index(road_river)], river_index);
+          current_riverlength++;
+          map_set_placed(ptile1);
+          log_debug("Applied a river to (%d, %d).", TILE_XY(ptile1));
+        } dbv_iterate_set_end;
       } else {
         log_debug("mapgen.c: A river failed. It might have gotten stuck "
                   "in a helix.");
@@ -1032,6 +1043,11 @@ static void make_rivers(void)
   dbv_free(&rivermap.blocked);
   dbv_free(&rivermap.ok);
 
+  extra_type_by_cause_iterate(EC_ROAD, proad) {
+    dbv_free(&road_tiles[extra_index(proad)]);
+  } extra_type_by_cause_iterate_end;
+  free(road_tiles);
+
   destroy_placed_map();
 }
 
@@ -179,6 +179,175 @@ bool is_normal_nat_pos(int x, int y)
   return is_normal_map_pos(x, y);
 }
 
+/**********************************************************************//**
+  Smoothed value of one tile from the values of the tiles at -2 .. 2
+  along an axis. 'nbr' holds their indices, or -1 for unreal positions.
+
+  The sums are done in the same order as axis_iterate() visits the
+  tiles, so the result is exactly what iterating over the tiles gives.
+**************************************************************************/
+static inline int smooth_int_value(const int *source_map, const int nbr[5],
+                                   const float weight[5],
+                                   bool zeroes_at_edges)
+{
+  float N = 0, D = 0;
+  int i;
+
+  for (i = 0; i < 5; i++) {
+    if (nbr[i] >= 0) {
+      D += weight[i];
+      N += weight[i] * source_map[nbr[i]];
+    }
+  }
+  if (zeroes_at_edges) {
+    D = 1;
+  }
+
+  return (float)N / D;
+}
+
+/**********************************************************************//**
+  Divisor for the tiles that have all four neighbours along the axis.
+**************************************************************************/
+static inline float smooth_int_divisor(const float weight[5],
+                                       bool zeroes_at_edges)
+{
+  float D = 0;
+  int i;
+
+  if (zeroes_at_edges) {
+    return 1;
+  }
+
+  /* Same summation order as in smooth_int_value() */
+  for (i = 0; i < 5; i++) {
+    D += weight[i];
+  }
+
+  return D;
+}
+
+/**********************************************************************//**
+  Return the native coordinate 'pos' moved by 'delta', wrapped if 'wrap',
+  or -1 if it falls off the map.
+**************************************************************************/
+static inline int smooth_int_map_step(int pos, int delta, int size,
+                                      bool wrap)
+{
+  pos += delta;
+
+  if (wrap) {
+    return FC_WRAP(pos, size);
+  }
+
+  return (pos < 0 || pos >= size) ? -1 : pos;
+}
+
+/**********************************************************************//**
+  One smoothing pass along the native X axis.
+
+  Works directly on the rows of the index arrays. Only the two tiles at
+  each end of a row need wrapping checks; the loop over the rest has no
+  branches, so the compiler can vectorize it.
+**************************************************************************/
+static void smooth_int_map_x(int *target_map, const int *source_map,
+                             const float weight[5], bool zeroes_at_edges)
+{
+  const int xsize = wld.map.xsize;
+  const int inner_end = MAX(2, xsize - 2);
+  const bool wrap = current_topo_has_flag(TF_WRAPX);
+  const float D = smooth_int_divisor(weight, zeroes_at_edges);
+  int i, x, y;
+
+  for (y = 0; y < wld.map.ysize; y++) {
+    const int *src = source_map + native_pos_to_index_nocheck(0, y);
+    int *dst = target_map + native_pos_to_index_nocheck(0, y);
+
+    for (x = 0; x < xsize; x++) {
+      int nbr[5];
+
+      if (x == 2) {
+        /* Inner part of the row */
+        for (; x < inner_end; x++) {
+          float N = 0;
+
+          N += weight[0] * src[x - 2];
+          N += weight[1] * src[x - 1];
+          N += weight[2] * src[x];
+          N += weight[3] * src[x + 1];
+          N += weight[4] * src[x + 2];
+          dst[x] = (float)N / D;
+        }
+        if (x >= xsize) {
+          break;
+        }
+      }
+
+      for (i = 0; i < 5; i++) {
+        int nx = smooth_int_map_step(x, i - 2, xsize, wrap);
+
+        nbr[i] = (nx >= 0 ? native_pos_to_index_nocheck(nx, y) : -1);
+      }
+      dst[x] = smooth_int_value(source_map, nbr, weight, zeroes_at_edges);
+    }
+  }
+}
+
+/**********************************************************************//**
+  One smoothing pass along the native Y axis.
+
+  Processes a whole row at a time so that the inner loop walks
+  contiguous memory; only the two rows at each end need wrapping checks.
+**************************************************************************/
+static void smooth_int_map_y(int *target_map, const int *source_map,
+                             const float weight[5], bool zeroes_at_edges)
+{
+  const int xsize = wld.map.xsize;
+  const int ysize = wld.map.ysize;
+  const bool wrap = current_topo_has_flag(TF_WRAPY);
+  const float D = smooth_int_divisor(weight, zeroes_at_edges);
+  int i, x, y;
+
+  for (y = 0; y < ysize; y++) {
+    int *dst = target_map + native_pos_to_index_nocheck(0, y);
+
+    if (y >= 2 && y < ysize - 2) {
+      /* Inner rows */
+      const int *rows[5];
+
+      for (i = 0; i < 5; i++) {
+        rows[i] = source_map + native_pos_to_index_nocheck(0, y + i - 2);
+      }
+
+      for (x = 0; x < xsize; x++) {
+        float N = 0;
+
+        N += weight[0] * rows[0][x];
+        N += weight[1] * rows[1][x];
+        N += weight[2] * rows[2][x];
+        N += weight[3] * rows[3][x];
+        N += weight[4] * rows[4][x];
+        dst[x] = (float)N / D;
+      }
+    } else {
+      int ny[5];
+
+      for (i = 0; i < 5; i++) {
+        ny[i] = smooth_int_map_step(y, i - 2, ysize, wrap);
+      }
+
+      for (x = 0; x < xsize; x++) {
+        int nbr[5];
+
+        for (i = 0; i < 5; i++) {
+          nbr[i] = (ny[i] >= 0 ? native_pos_to_index_nocheck(x, ny[i]) : -1);
+        }
+        dst[x] = smooth_int_value(source_map, nbr, weight, zeroes_at_edges);
+      }
+    }
+  }
+}
+
 /**********************************************************************//**
   Apply a Gaussian diffusion filter on the map. The size of the map is
   MAP_INDEX_SIZE and the map is indexed by native_pos_to_index function.
@@ -201,18 +370,11 @@ void smooth_int_map(int *int_map, bool zeroes_at_edges)
   source_map = int_map;
 
   do {
-    whole_map_iterate(&(wld.map), ptile) {
-      float N = 0, D = 0;
-
-      axis_iterate(&(wld.map), ptile, pnear, i, 2, axe) {
-        D += weight[i + 2];
-        N += weight[i + 2] * source_map[tile_index(pnear)];
-      } axis_iterate_end;
-      if (zeroes_at_edges) {
-        D = 1;
-      }
-      target_map[tile_index(ptile)] = (float)N / D;
-    } whole_map_iterate_end;
+    if (axe) {
+      smooth_int_map_x(target_map, source_map, weight, zeroes_at_edges);
+    } else {
+      smooth_int_map_y(target_map, source_map, weight, zeroes_at_edges);
+    }
 
     if (MAP_IS_ISOMETRIC) {
       weight = weight_isometric;
@@ -60,6 +60,40 @@
 /* Suppress send_tile_info() during game_load() */
 static bool send_tile_suppressed = FALSE;
 
+/* Nesting level of map_update_batch_begin() / map_update_batch_end(),
+ * and whether a whole map resend was postponed until the batch ends. */
+static int map_update_batch_level = 0;
+static bool map_update_batch_resend = FALSE;
+
+/* What the claims of a border source depended on when it was last
+ * evaluated. See map_refresh_borders(). */
+struct border_source_state {
+  struct player *owner;
+  int radius_sq;
+  int strength;
+  int city_radius_sq;
+  int claim_ocean;
+  int claim_ocean_limited;
+  unsigned int evaluated;  /* Pass of the last evaluation, 0 if no source */
+};
+
+/* State of the incremental border calculation. 'changed' holds, for each
+ * tile, the pass during which something that border claims depend on
+ * last changed there. */
+static struct {
+  bool valid;
+  unsigned int pass;
+  int num_tiles;
+  unsigned int *changed;
+  struct border_source_state *sources;
+
+  /* Settings the whole calculation depends on */
+  enum borders_mode borders;
+  int city_radius_sq;
+  int size_effect;
+  int permanent_radius_sq;
+} border_cache = { .valid = FALSE };
+
 static void player_tile_init(struct tile *ptile, struct player *pplayer);
 static void player_tile_free(struct tile *ptile, struct player *pplayer);
 static void give_tile_info_from_player_to_player(struct player *pfrom,
@@ -85,6 +119,7 @@ static inline int map_get_own_seen(const struct player *pplayer,
 
 static bool is_claimable_ocean(struct tile *ptile, struct tile *source,
                                struct player *pplayer);
+static inline void border_cache_tile_changed(const struct tile *ptile);
 
 /**********************************************************************//**
   Used only in global_warming() and nuclear_winter() below.
@@ -135,6 +170,8 @@ void climate_change(bool warming, int effect)
   log_verbose("Climate change: %s (%d)",
               warming ? "Global warming" : "Nuclear winter", effect);
 
+  map_update_batch_begin();
+
   while (effect > 0 && (k--) > 0) {
     struct terrain *old, *candidates[2], *new;
     struct tile *ptile;
@@ -213,6 +250,8 @@ void climate_change(bool warming, int effect)
       effect--;
     }
   }
+
+  map_update_batch_end();
 }
 
 /**********************************************************************//**
@@ -432,23 +471,58 @@ void send_all_known_tiles(struct conn_list *dest)
   /* send whole map piece by piece to each player to balance the load
      of the send buffers better */
   tiles_sent = 0;
+  conn_list_compression_freeze(dest);
   conn_list_do_buffer(dest);
 
   whole_map_iterate(&(wld.map), ptile) {
     tiles_sent++;
     if ((tiles_sent % wld.map.xsize) == 0) {
+      /* Each piece goes out as a single compressed frame. */
+      conn_list_compression_thaw(dest);
       conn_list_do_unbuffer(dest);
       flush_packets();
       conn_list_do_buffer(dest);
+      conn_list_compression_freeze(dest);
     }
 
     send_tile_info(dest, ptile, FALSE);
   } whole_map_iterate_end;
 
+  conn_list_compression_thaw(dest);
   conn_list_do_unbuffer(dest);
   flush_packets();
 }
 
+/**********************************************************************//**
+  Start a batch of map updates that touch many tiles, e.g. a climate
+  change or a border recalculation. Until the matching
+  map_update_batch_end() the tile info packets are collected into
+  compressed frames instead of being sent one by one, and any whole map
+  resend is postponed so that it happens only once. Batches may nest.
+**************************************************************************/
+void map_update_batch_begin(void)
+{
+  if (map_update_batch_level++ == 0) {
+    conn_list_compression_freeze(game.est_connections);
+  }
+}
+
+/**********************************************************************//**
+  End a batch of map updates started with map_update_batch_begin().
+**************************************************************************/
+void map_update_batch_end(void)
+{
+  fc_assert_ret(map_update_batch_level > 0);
+
+  if (--map_update_batch_level == 0) {
+    if (map_update_batch_resend) {
+      map_update_batch_resend = FALSE;
+      send_all_known_tiles(NULL);
+    }
+    conn_list_compression_thaw(game.est_connections);
+  }
+}
+
 /**********************************************************************//**
   Suppress send_tile_info() during game_load()
 **************************************************************************/
@@ -1092,6 +1166,7 @@ void change_playertile_site(struct player_tile *ptile,
 void map_set_known(struct tile *ptile, struct player *pplayer)
 {
   dbv_set(&pplayer->tile_known, tile_index(ptile));
+  border_cache_tile_changed(ptile);
 }
 
 /**********************************************************************//**
@@ -1100,6 +1175,7 @@ void map_set_known(struct tile *ptile, struct player *pplayer)
 void map_clear_known(struct tile *ptile, struct player *pplayer)
 {
   dbv_clr(&pplayer->tile_known, tile_index(ptile));
+  border_cache_tile_changed(ptile);
 }
 
 /**********************************************************************//**
@@ -1220,6 +1296,7 @@ void remove_player_from_maps(struct player *pplayer)
     /* Free all claimed tiles. */
     if (tile_owner(ptile) == pplayer) {
       tile_set_owner(ptile, NULL, NULL);
+      border_cache_tile_changed(ptile);
       reality_changed = TRUE;
     }
     if (extra_owner(ptile) == pplayer) {
@@ -1895,9 +1972,16 @@ void check_terrain_change(struct tile *ptile, struct terrain *oldter)
     } adjc_iterate_end;
   }
 
+  border_cache_tile_changed(ptile);
   if (need_to_reassign_continents(oldter, newter)) {
     assign_continent_numbers();
-    send_all_known_tiles(NULL);
+    map_borders_invalidate();
+    if (map_update_batch_level > 0) {
+      /* Sent once when the batch ends. */
+      map_update_batch_resend = TRUE;
+    } else {
+      send_all_known_tiles(NULL);
+    }
   }
 
   claimer = tile_claimer(ptile);
@@ -2015,6 +2099,7 @@ static void map_claim_border_ownership(struct tile *ptile,
   }
 
   tile_set_owner(ptile, powner, psource);
+  border_cache_tile_changed(ptile);
 
   /* Needed only when foggedborders enabled, but we do it unconditionally
    * in case foggedborders ever gets enabled later. Better to have correct
@@ -2199,7 +2284,152 @@ void map_claim_border(struct tile *ptile, struct player *owner,
 }
 
 /**********************************************************************//**
-  Update borders for all sources. Call this on turn end.
+  Record that something border claims depend on changed on the tile.
+**************************************************************************/
+static inline void border_cache_tile_changed(const struct tile *ptile)
+{
+  if (border_cache.valid) {
+    border_cache.changed[tile_index(ptile)] = border_cache.pass;
+  }
+}
+
+/**********************************************************************//**
+  Record a change on all tiles a border source may claim.
+**************************************************************************/
+static void border_cache_area_changed(struct tile *ptile, int radius_sq)
+{
+  circle_iterate(&(wld.map), ptile, radius_sq, dtile) {
+    border_cache.changed[tile_index(dtile)] = border_cache.pass;
+  } circle_iterate_end;
+}
+
+/**********************************************************************//**
+  Fill in what the claims of the border source on the tile depend on.
+**************************************************************************/
+static void border_source_state_get(struct tile *ptile,
+                                    struct border_source_state *state)
+{
+  struct city *pcity = tile_city(ptile);
+  struct player *owner = tile_owner(ptile);
+
+  state->owner = owner;
+  state->radius_sq = tile_border_source_radius_sq(ptile);
+  state->strength = tile_border_source_strength(ptile);
+  state->city_radius_sq = (pcity != NULL ? city_map_radius_sq_get(pcity) : 0);
+  state->claim_ocean = (owner != NULL
+                        ? num_known_tech_with_flag(owner, TF_CLAIM_OCEAN)
+                        : 0);
+  state->claim_ocean_limited
+    = (owner != NULL
+       ? num_known_tech_with_flag(owner, TF_CLAIM_OCEAN_LIMITED) : 0);
+}
+
+/**********************************************************************//**
+  Compare the border source state with the current state of the source.
+  If they differ, the stored state is updated and every tile the source
+  claimed, or may claim now, is marked as changed.
+**************************************************************************/
+static void border_source_state_update(struct tile *ptile,
+                                       struct border_source_state *state)
+{
+  struct border_source_state cur;
+
+  border_source_state_get(ptile, &cur);
+
+  if (state->evaluated == 0
+      || cur.owner != state->owner
+      || cur.radius_sq != state->radius_sq
+      || cur.strength != state->strength
+      || cur.city_radius_sq != state->city_radius_sq
+      || cur.claim_ocean != state->claim_ocean
+      || cur.claim_ocean_limited != state->claim_ocean_limited) {
+    border_cache_area_changed(ptile, MAX(cur.radius_sq, state->radius_sq));
+    cur.evaluated = state->evaluated;
+    *state = cur;
+  }
+}
+
+/**********************************************************************//**
+  Whether the border source needs to be evaluated again, i.e., anything
+  within its radius changed since the last evaluation.
+**************************************************************************/
+static bool border_source_needs_update(struct tile *ptile,
+                                       const struct border_source_state *state)
+{
+  if (state->evaluated == 0) {
+    return TRUE;
+  }
+
+  circle_iterate(&(wld.map), ptile, state->radius_sq, dtile) {
+    if (border_cache.changed[tile_index(dtile)] >= state->evaluated) {
+      return TRUE;
+    }
+  } circle_iterate_end;
+
+  return FALSE;
+}
+
+/**********************************************************************//**
+  Whether map_refresh_borders() can work from the state recorded by the
+  previous border calculation.
+**************************************************************************/
+static bool border_cache_usable(void)
+{
+  return (border_cache.valid
+          && border_cache.num_tiles == map_num_tiles()
+          && border_cache.borders == game.info.borders
+          && border_cache.city_radius_sq == game.info.border_city_radius_sq
+          && border_cache.size_effect == game.info.border_size_effect
+          && border_cache.permanent_radius_sq
+             == game.info.border_city_permanent_radius_sq);
+}
+
+/**********************************************************************//**
+  Reset the incremental border calculation state for a full calculation.
+**************************************************************************/
+static void border_cache_reset(void)
+{
+  int num_tiles = map_num_tiles();
+
+  if (border_cache.num_tiles != num_tiles) {
+    map_borders_invalidate();
+    border_cache.changed = fc_malloc(num_tiles
+                                     * sizeof(*border_cache.changed));
+    border_cache.sources = fc_malloc(num_tiles
+                                     * sizeof(*border_cache.sources));
+    border_cache.num_tiles = num_tiles;
+  }
+
+  memset(border_cache.changed, 0,
+         num_tiles * sizeof(*border_cache.changed));
+  memset(border_cache.sources, 0,
+         num_tiles * sizeof(*border_cache.sources));
+
+  border_cache.valid = TRUE;
+  border_cache.pass = 1;
+  border_cache.borders = game.info.borders;
+  border_cache.city_radius_sq = game.info.border_city_radius_sq;
+  border_cache.size_effect = game.info.border_size_effect;
+  border_cache.permanent_radius_sq
+    = game.info.border_city_permanent_radius_sq;
+}
+
+/**********************************************************************//**
+  Drop the state of the incremental border calculation, so that the next
+  map_refresh_borders() recalculates all borders. Call this when
+  something all border claims depend on, like the continent numbers,
+  changes.
+**************************************************************************/
+void map_borders_invalidate(void)
+{
+  border_cache.valid = FALSE;
+  border_cache.num_tiles = 0;
+  FC_FREE(border_cache.changed);
+  FC_FREE(border_cache.sources);
+}
+
+/**********************************************************************//**
+  Update borders for all sources.
 **************************************************************************/
 void map_calculate_borders(void)
 {
@@ -2214,17 +2444,96 @@ void map_calculate_borders(void)
 
   log_verbose("map_calculate_borders()");
 
+  border_cache_reset();
+
+  map_update_batch_begin();
   whole_map_iterate(&(wld.map), ptile) {
     if (is_border_source(ptile)) {
+      struct border_source_state *state
+        = border_cache.sources + tile_index(ptile);
+
+      border_source_state_get(ptile, state);
+      state->evaluated = border_cache.pass;
       map_claim_border(ptile, ptile->owner, -1);
     }
   } whole_map_iterate_end;
+  map_update_batch_end();
 
   log_verbose("map_calculate_borders() workers");
   city_thaw_workers_queue();
   city_refresh_queue_processing();
 }
 
+/**********************************************************************//**
+  Update borders for all sources. Call this on turn end.
+
+  Gives the same result as map_calculate_borders(), but only evaluates
+  the border sources for which something changed since the previous
+  calculation: the source itself (owner, size, radius, ocean claiming
+  techs) or any tile within its radius (claimer, knowledge, terrain,
+  another source's state).
+**************************************************************************/
+void map_refresh_borders(void)
+{
+  int evaluated = 0;
+
+  if (BORDERS_DISABLED == game.info.borders) {
+    return;
+  }
+
+  if (wld.map.tiles == NULL) {
+    /* Map not yet initialized */
+    return;
+  }
+
+  if (!border_cache_usable()) {
+    map_calculate_borders();
+    return;
+  }
+
+  log_verbose("map_refresh_borders()");
+
+  border_cache.pass++;
+
+  /* Collect changes of all sources first, so that the sources iterated
+   * before a changed one see the change just like in a full calculation. */
+  whole_map_iterate(&(wld.map), ptile) {
+    struct border_source_state *state
+      = border_cache.sources + tile_index(ptile);
+
+    if (is_border_source(ptile)) {
+      border_source_state_update(ptile, state);
+    } else if (state->evaluated != 0) {
+      /* No longer a border source */
+      border_cache_area_changed(ptile, state->radius_sq);
+      memset(state, 0, sizeof(*state));
+    }
+  } whole_map_iterate_end;
+
+  map_update_batch_begin();
+  whole_map_iterate(&(wld.map), ptile) {
+    if (is_border_source(ptile)) {
+      struct border_source_state *state
+        = border_cache.sources + tile_index(ptile);
+
+      /* Earlier claims during this pass may have changed the source. */
+      border_source_state_update(ptile, state);
+
+      if (border_source_needs_update(ptile, state)) {
+        state->evaluated = border_cache.pass;
+        map_claim_border(ptile, ptile->owner, -1);
+        evaluated++;
+      }
+    }
+  } whole_map_iterate_end;
+  map_update_batch_end();
+
+  log_verbose("map_refresh_borders() evaluated %d sources", evaluated);
+
+  city_thaw_workers_queue();
+  city_refresh_queue_processing();
+}
+
 /**********************************************************************//**
   Claim base to player's ownership.
 **************************************************************************/
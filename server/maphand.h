@@ -56,6 +56,8 @@ void give_citymap_from_player_to_player(struct city *pcity,
 void send_all_known_tiles(struct conn_list *dest);
 
 bool send_tile_suppression(bool now);
+void map_update_batch_begin(void);
+void map_update_batch_end(void);
 void send_tile_info(struct conn_list *dest, struct tile *ptile,
                     bool send_unknown);
 
@@ -106,6 +108,8 @@ void enable_fog_of_war_player(struct player *pplayer);
 void disable_fog_of_war_player(struct player *pplayer);
 
 void map_calculate_borders(void);
+void map_refresh_borders(void);
+void map_borders_invalidate(void);
 void map_claim_border(struct tile *ptile, struct player *powner,
                       int radius_sq);
 void map_claim_ownership(struct tile *ptile, struct player *powner,
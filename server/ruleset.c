@@ -199,6 +199,30 @@ static bool load_ruleset_veteran(struct section_file *file,
 char *script_buffer = NULL;
 char *parser_buffer = NULL;
 
+#ifdef USE_COMPRESSION
+/* The ruleset packets as last encoded for a connection with the given
+ * capability, and the same stream compressed. The encoding only depends
+ * on the ruleset and on the delta state of the connection, so connections
+ * joining later usually produce the very same stream, and the compressed
+ * form can be sent to them as is. */
+struct ruleset_stream {
+  char capability[MAX_LEN_CAPSTR];
+  struct byte_vector encoded;
+  struct byte_vector compressed;
+};
+
+#define SPECLIST_TAG ruleset_stream
+#define SPECLIST_TYPE struct ruleset_stream
+#include "speclist.h"
+#define ruleset_stream_list_iterate(streamlist, pstream) \
+    TYPED_LIST_ITERATE(struct ruleset_stream, streamlist, pstream)
+#define ruleset_stream_list_iterate_end  LIST_ITERATE_END
+
+static struct ruleset_stream_list *ruleset_streams = NULL;
+
+static void ruleset_streams_free(void);
+#endif /* USE_COMPRESSION */
+
 /**********************************************************************//**
   Notifications about ruleset errors to clients. Especially important in
   case of internal server crashing.
@@ -8113,6 +8137,9 @@ void rulesets_deinit(void)
 {
   script_server_free();
   requirement_vector_free(&reqs_list);
+#ifdef USE_COMPRESSION
+  ruleset_streams_free();
+#endif
 }
 
 /**********************************************************************//**
@@ -8135,6 +8162,9 @@ static bool load_rulesetdir(const char *rsdir, bool compat_mode,
   compat_info.log_cb = logger;
 
   game_ruleset_free();
+#ifdef USE_COMPRESSION
+  ruleset_streams_free();
+#endif
   /* Reset the list of available player colors. */
   playercolor_free();
   playercolor_init();
@@ -8359,13 +8389,99 @@ bool reload_rulesets_settings(void)
   return ok;
 }
 
+#ifdef USE_COMPRESSION
+/**********************************************************************//**
+  Free the cached ruleset packet streams.
+**************************************************************************/
+static void ruleset_streams_free(void)
+{
+  if (NULL == ruleset_streams) {
+    return;
+  }
+
+  ruleset_stream_list_iterate(ruleset_streams, pstream) {
+    byte_vector_free(&pstream->encoded);
+    byte_vector_free(&pstream->compressed);
+    free(pstream);
+  } ruleset_stream_list_iterate_end;
+  ruleset_stream_list_destroy(ruleset_streams);
+  ruleset_streams = NULL;
+}
+
+/**********************************************************************//**
+  Send the ruleset packets encoded for the connection, using the cached
+  compressed stream when the encoding matches it. Otherwise the cache
+  entry for the connection's capability is replaced.
+**************************************************************************/
+static void send_ruleset_stream(struct connection *pconn,
+                                const struct byte_vector *encoded)
+{
+  struct ruleset_stream *pstream = NULL;
+
+  if (NULL == ruleset_streams) {
+    ruleset_streams = ruleset_stream_list_new();
+  }
+
+  ruleset_stream_list_iterate(ruleset_streams, pcached) {
+    if (0 == strcmp(pcached->capability, pconn->capability)) {
+      pstream = pcached;
+      break;
+    }
+  } ruleset_stream_list_iterate_end;
+
+  if (NULL == pstream) {
+    pstream = fc_malloc(sizeof(*pstream));
+    sz_strlcpy(pstream->capability, pconn->capability);
+    byte_vector_init(&pstream->encoded);
+    byte_vector_init(&pstream->compressed);
+    ruleset_stream_list_append(ruleset_streams, pstream);
+  } else if (pstream->encoded.size == encoded->size
+             && (0 == encoded->size
+                 || 0 == memcmp(pstream->encoded.p, encoded->p,
+                                encoded->size))) {
+    log_debug("Reusing compressed ruleset stream for %s.",
+              conn_description(pconn));
+    conn_compression_send_compressed(pconn, pstream->compressed.p,
+                                     pstream->compressed.size);
+    return;
+  }
+
+  byte_vector_copy(&pstream->encoded, encoded);
+  byte_vector_reserve(&pstream->compressed, 0);
+  compress_packet_stream(encoded->p, encoded->size, &pstream->compressed);
+  log_debug("Compressed ruleset stream for %s: %lu bytes to %lu.",
+            conn_description(pconn),
+            (unsigned long) byte_vector_size(&pstream->encoded),
+            (unsigned long) byte_vector_size(&pstream->compressed));
+
+  conn_compression_send_compressed(pconn, pstream->compressed.p,
+                                   pstream->compressed.size);
+}
+#endif /* USE_COMPRESSION */
+
 /**********************************************************************//**
   Send all ruleset information to the specified connections.
 **************************************************************************/
 void send_rulesets(struct conn_list *dest)
 {
+#ifdef USE_COMPRESSION
+  struct byte_vector *encoded;
+  int i = 0;
+#endif /* USE_COMPRESSION */
+
   conn_list_compression_freeze(dest);
 
+#ifdef USE_COMPRESSION
+  /* Collect the encoded packets per connection, so that they need to be
+   * compressed only when they differ from the cached stream. */
+  encoded = fc_calloc(MAX(conn_list_size(dest), 1), sizeof(*encoded));
+  conn_list_iterate(dest, pconn) {
+    byte_vector_init(&encoded[i]);
+    conn_compression_capture(pconn, &encoded[i]);
+    i++;
+  } conn_list_iterate_end;
+#endif /* USE_COMPRESSION */
+
   /* ruleset_control also indicates to client that ruleset sending starts. */
   send_ruleset_control(dest);
 
@@ -8401,6 +8517,17 @@ void send_rulesets(struct conn_list *dest)
   /* Indicate client that all rulesets have now been sent. */
   lsend_packet_rulesets_ready(dest);
 
+#ifdef USE_COMPRESSION
+  i = 0;
+  conn_list_iterate(dest, pconn) {
+    conn_compression_capture(pconn, NULL);
+    send_ruleset_stream(pconn, &encoded[i]);
+    byte_vector_free(&encoded[i]);
+    i++;
+  } conn_list_iterate_end;
+  free(encoded);
+#endif /* USE_COMPRESSION */
+
   /* changed game settings will be send in
    * connecthand.c:establish_new_connection() */
 
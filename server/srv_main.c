@@ -1055,6 +1055,13 @@ static void kill_dying_players(void)
 **************************************************************************/
 static void ai_start_phase(void)
 {
+  /* Let every AI player look at the world before any of them moves. */
+  phase_players_iterate(pplayer) {
+    if (is_ai(pplayer)) {
+      CALL_PLR_AI_FUNC(phase_plan, pplayer, pplayer);
+    }
+  } phase_players_iterate_end;
+
   phase_players_iterate(pplayer) {
     if (is_ai(pplayer)) {
       CALL_PLR_AI_FUNC(first_activities, pplayer, pplayer);
@@ -1431,7 +1438,7 @@ static void end_turn(void)
 
   lsend_packet_end_turn(game.est_connections);
 
-  map_calculate_borders();
+  map_refresh_borders();
 
   /* Output some AI measurement information */
   players_iterate(pplayer) {
@@ -3315,6 +3322,8 @@ void server_game_free(void)
     } city_list_iterate_end;
   } players_iterate_end;
 
+  map_borders_invalidate();
+
   /* Destroy all players; with must be separate as the player information is
    * needed above. This also sends the information to the clients. */
   players_iterate(pplayer) {
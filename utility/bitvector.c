@@ -197,6 +197,23 @@ bool dbv_are_equal(const struct dbv *pdbv1, const struct dbv *pdbv2)
                       _BV_BYTES(pdbv2->bits));
 }
 
+/***********************************************************************//**
+  Set in 'pdbv' all the bits that are set in 'psrc'. Both bitvectors
+  must be of the same size.
+***************************************************************************/
+void dbv_or(struct dbv *pdbv, const struct dbv *psrc)
+{
+  int i;
+
+  fc_assert_ret(pdbv != NULL && pdbv->vec != NULL);
+  fc_assert_ret(psrc != NULL && psrc->vec != NULL);
+  fc_assert_ret(pdbv->bits == psrc->bits);
+
+  for (i = 0; i < _BV_BYTES(pdbv->bits); i++) {
+    pdbv->vec[i] |= psrc->vec[i];
+  }
+}
+
 /***********************************************************************//**
   Debug a dynamic bitvector.
 ***************************************************************************/
@@ -50,9 +50,35 @@ void dbv_clr(struct dbv *pdbv, int bit);
 void dbv_clr_all(struct dbv *pdbv);
 
 bool dbv_are_equal(const struct dbv *pdbv1, const struct dbv *pdbv2);
+void dbv_or(struct dbv *pdbv, const struct dbv *psrc);
 
 void dbv_debug(struct dbv *pdbv);
 
+/* Iterate over the indices of the set bits of a dynamic bitvector, in
+ * increasing order. Bytes with no bits set are skipped as a whole. */
+#define dbv_iterate_set(pdbv, _bit)                                         \
+{                                                                           \
+  const struct dbv *_bit##_dbv = (pdbv);                                    \
+  const int _bit##_bytes = _BV_BYTES(_bit##_dbv->bits);                     \
+  int _bit##_byte;                                                          \
+                                                                            \
+  for (_bit##_byte = 0; _bit##_byte < _bit##_bytes; _bit##_byte++) {        \
+    const int _bit##_end = (_bit##_byte + 1 < _bit##_bytes                  \
+                            ? (_bit##_byte + 1) * 8 : _bit##_dbv->bits);    \
+    int _bit;                                                               \
+                                                                            \
+    if (_bit##_dbv->vec[_bit##_byte] == 0) {                                \
+      continue;                                                             \
+    }                                                                       \
+    for (_bit = _bit##_byte * 8; _bit < _bit##_end; _bit++) {               \
+      if ((_bit##_dbv->vec[_bit##_byte] & _BV_BITMASK(_bit)) != 0) {
+
+#define dbv_iterate_set_end                                                 \
+      }                                                                     \
+    }                                                                       \
+  }                                                                         \
+}
+
 /* Maximal size of a dynamic bitvector.
    Use a large value to be on the safe side (4Mbits = 512kbytes). */
 #define MAX_DBV_LENGTH (4 * 1024 * 1024)